@@ -34,6 +34,11 @@
 #include <algorithm>
 #include <random>
 
+#if !defined(FN_USE_DOUBLES) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FN_SIMPLEX_SET_SSE2
+#include <emmintrin.h>
+#endif
+
 const FN_DECIMAL GRAD_X[] =
 {
 	1, -1, 1, -1,
@@ -1329,6 +1334,119 @@ FN_DECIMAL FastNoise::SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIM
 	return 70 * (n0 + n1 + n2);
 }
 
+#ifdef FN_SIMPLEX_SET_SSE2
+// Matches FastFloor(), truncate then subtract 1 from negative values
+static __m128i FastFloor4(__m128 f)
+{
+	__m128i negative = _mm_castps_si128(_mm_cmplt_ps(f, _mm_setzero_ps()));
+	return _mm_add_epi32(_mm_cvttps_epi32(f), negative);
+}
+
+// Same operation order as SingleSimplex(offset, x, y) so results match the scalar path
+static __m128 SingleSimplex4(const unsigned char* perm, const unsigned char* perm12, unsigned char offset, __m128 x, __m128 y)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 f2 = _mm_set1_ps(F2);
+	const __m128 g2 = _mm_set1_ps(G2);
+	const __m128 g2x2 = _mm_set1_ps(2 * G2);
+
+	__m128 t = _mm_mul_ps(_mm_add_ps(x, y), f2);
+	__m128i i = FastFloor4(_mm_add_ps(x, t));
+	__m128i j = FastFloor4(_mm_add_ps(y, t));
+
+	t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), g2);
+	__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+	__m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+	__m128 upper = _mm_cmpgt_ps(x0, y0);
+	__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(upper, one)), g2);
+	__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(upper, one)), g2);
+	__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), g2x2);
+	__m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), g2x2);
+
+	// Gradient lookups are gathered per lane
+	alignas(16) int iLane[4], jLane[4], upperLane[4];
+	alignas(16) float gx0[4], gy0[4], gx1[4], gy1[4], gx2[4], gy2[4];
+	_mm_store_si128((__m128i*)iLane, i);
+	_mm_store_si128((__m128i*)jLane, j);
+	_mm_store_si128((__m128i*)upperLane, _mm_castps_si128(upper));
+
+	for (int l = 0; l < 4; l++)
+	{
+		int i1 = upperLane[l] ? 1 : 0;
+		int j1 = 1 - i1;
+
+		unsigned char lut0 = perm12[(iLane[l] & 0xff) + perm[(jLane[l] & 0xff) + offset]];
+		unsigned char lut1 = perm12[((iLane[l] + i1) & 0xff) + perm[((jLane[l] + j1) & 0xff) + offset]];
+		unsigned char lut2 = perm12[((iLane[l] + 1) & 0xff) + perm[((jLane[l] + 1) & 0xff) + offset]];
+
+		gx0[l] = GRAD_X[lut0]; gy0[l] = GRAD_Y[lut0];
+		gx1[l] = GRAD_X[lut1]; gy1[l] = GRAD_Y[lut1];
+		gx2[l] = GRAD_X[lut2]; gy2[l] = GRAD_Y[lut2];
+	}
+
+	__m128 t0 = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0));
+	__m128 t1 = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+	__m128 t2 = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2));
+
+	__m128 grad0 = _mm_add_ps(_mm_mul_ps(x0, _mm_load_ps(gx0)), _mm_mul_ps(y0, _mm_load_ps(gy0)));
+	__m128 grad1 = _mm_add_ps(_mm_mul_ps(x1, _mm_load_ps(gx1)), _mm_mul_ps(y1, _mm_load_ps(gy1)));
+	__m128 grad2 = _mm_add_ps(_mm_mul_ps(x2, _mm_load_ps(gx2)), _mm_mul_ps(y2, _mm_load_ps(gy2)));
+
+	__m128 inside0 = _mm_cmpge_ps(t0, _mm_setzero_ps());
+	__m128 inside1 = _mm_cmpge_ps(t1, _mm_setzero_ps());
+	__m128 inside2 = _mm_cmpge_ps(t2, _mm_setzero_ps());
+
+	t0 = _mm_mul_ps(t0, t0);
+	t1 = _mm_mul_ps(t1, t1);
+	t2 = _mm_mul_ps(t2, t2);
+
+	__m128 n0 = _mm_and_ps(inside0, _mm_mul_ps(_mm_mul_ps(t0, t0), grad0));
+	__m128 n1 = _mm_and_ps(inside1, _mm_mul_ps(_mm_mul_ps(t1, t1), grad1));
+	__m128 n2 = _mm_and_ps(inside2, _mm_mul_ps(_mm_mul_ps(t2, t2), grad2));
+
+	return _mm_mul_ps(_mm_set1_ps(70.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+}
+#endif
+
+void FastNoise::FillSimplexFractalSet(FN_DECIMAL* noiseSet, const FN_DECIMAL* xSet, const FN_DECIMAL* ySet, int size) const
+{
+	int index = 0;
+
+#ifdef FN_SIMPLEX_SET_SSE2
+	if (m_fractalType == FBM)
+	{
+		const __m128 frequency = _mm_set1_ps(m_frequency);
+		const __m128 lacunarity = _mm_set1_ps(m_lacunarity);
+
+		for (; index + 4 <= size; index += 4)
+		{
+			__m128 x = _mm_mul_ps(_mm_loadu_ps(xSet + index), frequency);
+			__m128 y = _mm_mul_ps(_mm_loadu_ps(ySet + index), frequency);
+
+			__m128 sum = SingleSimplex4(m_perm, m_perm12, m_perm[0], x, y);
+			FN_DECIMAL amp = 1;
+			int i = 0;
+
+			while (++i < m_octaves)
+			{
+				x = _mm_mul_ps(x, lacunarity);
+				y = _mm_mul_ps(y, lacunarity);
+
+				amp *= m_gain;
+				sum = _mm_add_ps(sum, _mm_mul_ps(SingleSimplex4(m_perm, m_perm12, m_perm[i], x, y), _mm_set1_ps(amp)));
+			}
+
+			_mm_storeu_ps(noiseSet + index, _mm_mul_ps(sum, _mm_set1_ps(m_fractalBounding)));
+		}
+	}
+#endif
+
+	for (; index < size; index++)
+		noiseSet[index] = GetSimplexFractal(xSet[index], ySet[index]);
+}
+
 FN_DECIMAL FastNoise::GetSimplex(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const
 {
 	return SingleSimplex(0, x * m_frequency, y * m_frequency, z * m_frequency, w * m_frequency);
@@ -171,6 +171,10 @@ public:
 	FN_DECIMAL GetSimplex(FN_DECIMAL x, FN_DECIMAL y) const;
 	FN_DECIMAL GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y) const;
 
+	// Fills noiseSet[i] with GetSimplexFractal(xSet[i], ySet[i])
+	// FBM is evaluated 4 points at a time when SSE2 is available
+	void FillSimplexFractalSet(FN_DECIMAL* noiseSet, const FN_DECIMAL* xSet, const FN_DECIMAL* ySet, int size) const;
+
 	FN_DECIMAL GetCellular(FN_DECIMAL x, FN_DECIMAL y) const;
 
 	FN_DECIMAL GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y) const;
@@ -135,7 +135,7 @@ void QEFSolver::add(const QEFData &rhs)
 	this->data.add(rhs);
 }
 
-QEFData QEFSolver::getData()
+QEFData QEFSolver::getData() const
 {
 	return data;
 }
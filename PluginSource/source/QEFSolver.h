@@ -52,7 +52,7 @@ public:
 		float nx, float ny, float nz);
 	void add(const Vec3 &p, const Vec3 &n);
 	void add(const QEFData &rhs);
-	QEFData getData();
+	QEFData getData() const;
 	float getError();
 	float getError(const Vec3 &pos);
 	void reset();
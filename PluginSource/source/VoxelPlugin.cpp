@@ -79,8 +79,10 @@ void error(GLenum e)
 
 static GLuint * s_vboArr;
 static GLuint * s_eboArr;
+static GLuint * s_seamEboArr;
 static glm::vec3 * s_chunkIndicesToBind;
 static GLuint s_count;
+static GLuint s_seamCount;
 
 //
 extern "C"
@@ -114,6 +116,15 @@ extern "C"
 		s_eboArr = EBOs;
 		s_count = (GLuint)count;
 	}
+
+	//optional, seam index buffers for the chunks passed to SetChunkBuffers in the same order.
+	//seams index the chunk's vbo, which holds the body vertices followed by the seam's own.
+	//ignored unless count covers every chunk being bound
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetChunkSeamBuffers(int count, void * eboArr)
+	{
+		s_seamEboArr = (GLuint *)(size_t*)eboArr;
+		s_seamCount = count > 0 ? (GLuint)count : 0;
+	}
 	
 	int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetNewChunkCount()
 	{
@@ -126,16 +137,55 @@ extern "C"
 		s_VoxelManager->GetNewChunkTriangles(count, triArr);
 	}
 
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetNewChunkSeamTriangles(int count, int *triArr)
+	{
+		s_VoxelManager->GetNewChunkSeamTriangles(count, triArr);
+	}
+
 	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetNewChunkIndices(int count, glm::vec3 * indices)
 	{
 		s_VoxelManager->GetNewChunkIndices(count, indices);
 	}
 
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetNewChunkStats(int count, ChunkMeshStats *stats)
+	{
+		s_VoxelManager->GetNewChunkStats(count, stats);
+	}
+
 	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API Update(glm::vec3 playerPos)
 	{
 		s_VoxelManager->Update(playerPos);
 	}
 
+	//generation prefers chunks in front of the player along viewDirection
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UpdateWithView(glm::vec3 playerPos, glm::vec3 viewDirection)
+	{
+		s_VoxelManager->Update(playerPos, viewDirection);
+	}
+
+	//chunk data kept before chunks that left the render range are evicted, least recently in range first
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetChunkMemoryBudget(int megabytes)
+	{
+		s_VoxelManager->SetMemoryBudget((size_t)megabytes * 1024 * 1024);
+	}
+
+	//heightmap tiles cached for terrain generation, defaults to HEIGHTMAP_CACHE_TILES
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetHeightMapCacheCapacity(int tiles)
+	{
+		s_VoxelManager->SetHeightMapCacheCapacity((size_t)glm::max(tiles, 0));
+	}
+
+	int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetRetiredChunkCount()
+	{
+		return s_VoxelManager->GetRetiredChunkCount();
+	}
+
+	//removes the returned indices from the list, the meshes of these chunks can be released
+	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetRetiredChunkIndices(int count, glm::vec3 *indices)
+	{
+		s_VoxelManager->GetRetiredChunkIndices(count, indices);
+	}
+
 	void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetActiveChunkPositions(int count, glm::vec3 *positions)
 	{
 		s_VoxelManager->GetActiveChunkPositions(count, positions);
@@ -164,12 +214,19 @@ extern "C"
 		case RenderEvents::BindChunks:
 			if (s_count == 0) 
 				break;
-			s_VoxelManager->BindChunks(s_count, s_chunkIndicesToBind, s_vboArr, s_eboArr);
+			if (s_seamEboArr && s_seamCount < s_count)
+			{
+				LogToUnity("Seam buffer count is smaller than the chunk count, seams are not bound");
+				s_seamEboArr = nullptr;
+			}
+			s_VoxelManager->BindChunks(s_count, s_chunkIndicesToBind, s_vboArr, s_eboArr, s_seamEboArr);
 			//reset static vars
 			s_count = 0;
 			s_chunkIndicesToBind = nullptr;
 			s_vboArr = nullptr;
 			s_eboArr = nullptr;
+			s_seamEboArr = nullptr;
+			s_seamCount = 0;
 			break;
 		default:
 			break;
@@ -6,7 +6,14 @@
 #include <assert.h>
 #include <math.h>
 #include <unordered_map>
+#include <unordered_set>
+#include <list>
+#include <memory>
+#include <new>
+#include <mutex>
+#include <algorithm>
 #include <stddef.h>
+#include <stdint.h>
 #include "GLEW/glew.h"
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/glm.hpp"
@@ -26,10 +33,20 @@ using namespace std;
 #include "tables.hpp"
 #include "SVD.h"
 #include "QEFSolver.h"
+#include "qefBatch.hpp"
 #include "VoxelVertex.hpp"
+#include "memoryArena.hpp"
+#include "heightMapCache.hpp"
+#include "occupancyGrid.hpp"
+#include "hermiteGrid.hpp"
 #include "density.hpp"
 #include "octree.hpp"
+#include "linearOctree.hpp"
+#include "nodeGrid.hpp"
 #include "chunk.hpp"
+#include "chunkPool.hpp"
+#include "chunkGrid.hpp"
+#include "chunkQueue.hpp"
 #include "voxelManager.hpp"
 
 #include "Unity/IUnityInterface.h"
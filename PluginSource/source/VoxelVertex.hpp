@@ -7,17 +7,16 @@ enum VoxelVertexFlags
 	FACEPROP2 = 2
 };
 
-class VoxelVertex
+class VoxelVertex;
+
+//Cold simplification data of a vertex. Lives in its own arena and is
+//released once the chunk's mesh is generated
+class VoxelVertexData
 {
 public:
 	QEFSolver qef;
 	VoxelVertex* parent;
-	glm::vec3 position;
-	glm::vec3 normal;
-	int textureID;
-	int flip;
 
-	unsigned int index;
 	int surface_index;
 	unsigned char flags;
 	float error;
@@ -26,15 +25,29 @@ public:
 	unsigned char in_cell;
 
 public:
-	VoxelVertex();
-	~VoxelVertex();
+	VoxelVertexData();
 
 	inline bool IsCollapsible() { return (flags & VoxelVertexFlags::COLLAPSIBLE) != 0; }
 	inline bool IsManifold() { return euler == 1 && (flags & VoxelVertexFlags::FACEPROP2) != 0; }
 };
 
+//Hot vertex data read while contouring and building vertex buffers
+class VoxelVertex
+{
+public:
+	glm::vec3 position;
+	glm::vec3 normal;
+	unsigned int index;
+	VoxelVertexData *data; //null once the chunk released its simplification data
+
+public:
+	VoxelVertex();
+
+	inline VoxelVertex *GetParent() const { return data ? data->parent : nullptr; }
+};
+
 struct Vertex
 {
 	glm::vec3 pos;
 	glm::vec3 normal;
-};
\ No newline at end of file
+};
@@ -4,6 +4,9 @@
 #define GENERATED_SEAM 2
 #define CHUNK_RENDERING 4
 #define CHUNK_BINDED 8
+#define SEAM_DIRTY 16
+
+#define CHUNK_SEAM_VERTEX_RESERVE 256 //room left after the body in a new vbo for seam vertices
 
 static const glm::vec3 AXIS_OFFSET[3] =
 {
@@ -12,7 +15,7 @@ static const glm::vec3 AXIS_OFFSET[3] =
 	glm::vec3(0.f, 0.f, 1.f)
 };
 
-Chunk::Chunk() : m_flag(0), m_vbo(0), m_ebo(0)
+Chunk::Chunk() : m_flag(0), m_lodError(-1.f), m_lodLevel(0), m_leafVertexCount(0), m_dirtySeamRegions(SEAM_ALL_REGIONS), m_vbo(0), m_ebo(0), m_seamEbo(0), m_vboCapacity(0)
 {
 
 }
@@ -23,19 +26,62 @@ Chunk::~Chunk()
 	ClearBufferedData();
 }
 
-bool Chunk::Init(glm::ivec3 chunkIndices, glm::vec3 chunkSize, Density::DensityType type, int voxelSize)
+int Chunk::GetLodLevel(int chunkDistance, int chunkSize)
+{
+	//the cells of a coarser ring must tile the chunk exactly or its footprint and seams drift
+	int lod = chunkDistance / CHUNK_LOD_RING_SIZE;
+	while (lod > 0 && ((chunkSize >> lod) < CHUNK_LOD_MIN_CELLS || chunkSize % (1 << lod) != 0))
+		lod--;
+	return lod;
+}
+
+int Chunk::GetLodLevel() const
+{
+	return m_lodLevel;
+}
+
+float Chunk::GetLodError(int chunkDistance, int voxelSize)
+{
+	if (chunkDistance <= CHUNK_LOD_FULL_DETAIL_RANGE)
+		return -1.f;
+
+	const float distance = (float)(chunkDistance - CHUNK_LOD_FULL_DETAIL_RANGE);
+	return CHUNK_LOD_ERROR * distance * distance * (float)(voxelSize * voxelSize);
+}
+
+bool Chunk::Init(glm::ivec3 chunkIndices, glm::vec3 chunkSize, Density::DensityType type, int voxelSize, float lodError, int lodLevel)
 {
 	m_chunkIndex = chunkIndices;
 	m_chunkSize = chunkSize;
 	m_voxelSize = voxelSize;
 	m_invVoxelSize = 1.0f / (float)m_voxelSize;
+	m_lodError = lodError;
+	m_lodLevel = lodLevel;
+	m_leafVertexCount = 0;
+	m_flag = 0;
+
+	m_vertices.clear();
+	m_triIndices.clear();
+	m_seamVertices.clear();
+	m_seamIndices.clear();
+	for (int region = 0; region < SEAM_REGION_COUNT; region++)
+	{
+		m_seamRegions[region].vertices.clear();
+		m_seamRegions[region].indices.clear();
+	}
+	m_dirtySeamRegions = SEAM_ALL_REGIONS;
 
 	m_terrainType = type;
 	
 	m_position = chunkIndices * voxelSize;
 	m_position *= chunkSize;
 
-	memset(m_neighbors, NULL, sizeof(m_neighbors));
+	std::fill(std::begin(m_neighbors), std::end(m_neighbors), nullptr);
+
+	//drop the previous octree in one go
+	m_octree.Clear();
+	m_arena.Reset();
+	m_vertexDataArena.Reset();
 
 	vector<float> densityField;
 
@@ -48,7 +94,7 @@ bool Chunk::Init(glm::ivec3 chunkIndices, glm::vec3 chunkSize, Density::DensityT
 	}
 
 	FindActiveVoxels();
-	if (m_nodeMap.size() == 0)
+	if (m_nodeGrid.GetNodeCount() == 0)
 	{
 		m_flag = ~CHUNK_ACTIVE;
 		return false;
@@ -61,7 +107,7 @@ bool Chunk::Init(glm::ivec3 chunkIndices, glm::vec3 chunkSize, Density::DensityT
 
 	GenerateMesh();
 
-	if(m_root == nullptr) return false;
+	if(!IsActive()) return false;
 
 	return true;
 }
@@ -70,6 +116,7 @@ void Chunk::ClearBufferedData()
 {
 	if (m_vbo) glDeleteBuffers(1, &m_vbo);
 	if (m_ebo) glDeleteBuffers(1, &m_ebo);
+	if (m_seamEbo) glDeleteBuffers(1, &m_seamEbo);
 
 }
 
@@ -108,117 +155,142 @@ void Chunk::AssignNeighbor(Chunk *chunk, Side side)
 
 void Chunk::FindActiveVoxels()
 {
-	vector<glm::vec3> positions;
+	vector<glm::ivec3> cells;
 	vector<int> cornersArray;
 
-	glm::vec3 gridSize = m_chunkSize + glm::vec3(1.0f);
-	for (int x = 0; x < m_chunkSize.x; x++)
-	{
-		for (int y = 0; y < m_chunkSize.y; y++)
-		{
-			for (int z = 0; z < m_chunkSize.z; z++)
-			{
-				int corners = 0;
-
-				for (int i = 0; i < 8; i++)
-				{
-					glm::ivec3 cornerIndex = glm::vec3(x, y, z) + CHILD_MIN_OFFSETS[i];
-					corners |= (m_materialIndices[GETINDEXCHUNK(gridSize, cornerIndex.x, cornerIndex.y, cornerIndex.z)] << i);
-				}
-				if (corners == 0 || corners == 255) continue;
-
-				positions.push_back(m_position + glm::vec3(x, y, z) * (float)m_voxelSize);
-				cornersArray.push_back(corners);
-			}
-		}
-	}
+	m_occupancy.FindActiveCells(cells, cornersArray);
 
-	Octree *nodes = new Octree[positions.size()];
-	for (int i = 0; i < positions.size(); i++)
+	Octree *nodes = m_arena.NewArray<Octree>(cells.size());
+	for (size_t i = 0; i < cells.size(); i++)
 	{
-		nodes[i].InitNode(positions[i], m_voxelSize, cornersArray[i]);
-		m_nodeMap.insert(std::pair<glm::vec3, Octree*>(positions[i], &nodes[i]));
+		glm::vec3 position = m_position + glm::vec3(cells[i]) * (float)m_voxelSize;
+		nodes[i].InitNode(position, m_voxelSize, cornersArray[i]);
 	}
+
+	m_nodeGrid.Build(glm::ivec3(m_chunkSize), cells, nodes);
 }
 
-void Chunk::GetNodesInRange(const Chunk * chunk, const glm::ivec3 minrange, const glm::ivec3 maxrange, vector<Octree*> &outputNodes)
+Chunk *Chunk::GetSeamNeighbor(int offset)
 {
-	for (int x = minrange.x; x <= maxrange.x; x++)
+	switch (offset)
 	{
-		for (int y = minrange.y; y <= maxrange.y; y++)
-		{
-			for (int z = minrange.z; z <= maxrange.z; z++)
-			{
-				const glm::vec3 key = chunk->m_position + glm::vec3(x, y, z) * (float)chunk->m_voxelSize;
-				const auto & iterator = chunk->m_nodeMap.find(key);
-				if (iterator != chunk->m_nodeMap.end())
-				{
-					outputNodes.push_back(iterator->second);
-				}
-			}
-		}
+	case 0:
+		return this;
+	case SEAM_RIGHT:
+		return m_neighbors[RIGHT];
+	case SEAM_TOP:
+		return m_neighbors[TOP];
+	case SEAM_FRONT:
+		return m_neighbors[FRONT];
+	case SEAM_FRONT_RIGHT:
+		return m_neighbors[FRONT_RIGHT];
+	case SEAM_TOP_RIGHT:
+		return m_neighbors[TOP] ? m_neighbors[TOP]->m_neighbors[RIGHT] : nullptr;
+	case SEAM_TOP_FRONT:
+		return m_neighbors[TOP] ? m_neighbors[TOP]->m_neighbors[FRONT] : nullptr;
+	default:
+		return nullptr;
 	}
 }
 
-vector<Octree*> Chunk::FindSeamNodes()
+vector<Octree*> Chunk::FindSeamNodes(int region)
 {
 	vector<Octree*> nodes;
 
-	//get 7 neighbors
-	if (m_neighbors[TOP])
+	//every chunk the region touches adds its precomputed layer of cells next to the region's boundaries
+	for (int offset = 0; offset < SEAM_REGION_COUNT; offset++)
 	{
-		GetNodesInRange(this, glm::ivec3(0, m_chunkSize.y - 1, 0), glm::ivec3(m_chunkSize), nodes);
-		GetNodesInRange(m_neighbors[TOP], glm::ivec3(0), glm::ivec3(m_chunkSize.x, 0, m_chunkSize.z), nodes);
-	}
+		if ((offset & region) != offset)
+			continue;
 
-	if (m_neighbors[RIGHT])
-	{
-		GetNodesInRange(this, glm::ivec3(m_chunkSize.x - 1, 0, 0), glm::ivec3(m_chunkSize), nodes);
-		GetNodesInRange(m_neighbors[RIGHT], glm::ivec3(0), glm::ivec3(0, m_chunkSize.y, m_chunkSize.z), nodes);
-	}
+		Chunk *chunk = GetSeamNeighbor(offset);
+		if (!chunk || !chunk->IsActive())
+			continue;
 
-	if (m_neighbors[FRONT])
-	{
-		GetNodesInRange(this, glm::ivec3(0, 0, m_chunkSize.z - 1), glm::ivec3(m_chunkSize), nodes);
-		GetNodesInRange(m_neighbors[FRONT], glm::ivec3(0), glm::ivec3(m_chunkSize.x, m_chunkSize.y, 0), nodes);
+		//first layer past the boundary, last layer before it
+		const vector<Octree*> &boundary = chunk->m_nodeGrid.GetBoundaryNodes(region, ~offset);
+		nodes.insert(nodes.end(), boundary.begin(), boundary.end());
 	}
 
-	if (m_neighbors[FRONT_RIGHT])
-	{		
-		GetNodesInRange(m_neighbors[FRONT_RIGHT], glm::ivec3(0), glm::ivec3(0, m_chunkSize.y, 0), nodes);
-	}
-	
-	if (m_neighbors[TOP] && m_neighbors[TOP]->m_neighbors[RIGHT])
+	return nodes;
+}
+
+void Chunk::MarkSeamDirty(const glm::ivec3 &neighborOffset)
+{
+	const int offset = (neighborOffset.x ? 1 : 0) | (neighborOffset.y ? 2 : 0) | (neighborOffset.z ? 4 : 0);
+	for (int region = 1; region < SEAM_REGION_COUNT; region++)
 	{
-		GetNodesInRange(m_neighbors[TOP]->m_neighbors[RIGHT], glm::ivec3(0), glm::ivec3(0, 0, m_chunkSize.z), nodes);
+		if ((region & offset) == offset)
+			m_dirtySeamRegions |= 1 << region;
 	}
+}
 
-	if (m_neighbors[TOP] && m_neighbors[TOP]->m_neighbors[FRONT])
+void Chunk::GenerateSeam()
+{
+	const int dirty = m_dirtySeamRegions;
+	m_dirtySeamRegions = 0;
+	for (int region = 1; region < SEAM_REGION_COUNT; region++)
 	{
-		GetNodesInRange(m_neighbors[TOP]->m_neighbors[FRONT], glm::ivec3(0), glm::ivec3(m_chunkSize.x, 0, 0), nodes);
+		if (dirty & 1 << region)
+			GenerateSeamRegion(region);
 	}
 
-	if (m_neighbors[TOP] && m_neighbors[TOP]->m_neighbors[FRONT_RIGHT])
+	//the previous seam is dropped, regenerating never grows the buffers
+	const GLuint bodyCount = m_vertices.size();
+	m_seamVertices.clear();
+	m_seamIndices.clear();
+	for (int region = 1; region < SEAM_REGION_COUNT; region++)
 	{
-		GetNodesInRange(m_neighbors[TOP]->m_neighbors[FRONT_RIGHT], glm::ivec3(0), glm::ivec3(0, m_chunkSize.y, 0), nodes);
+		const SeamMesh &mesh = m_seamRegions[region];
+		const GLuint offset = m_seamVertices.size();
+		m_seamVertices.insert(m_seamVertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+		for (GLuint index : mesh.indices)
+			m_seamIndices.push_back(index < bodyCount ? index : index + offset);
 	}
 
-	return nodes;
+	m_flag |= GENERATED_SEAM | SEAM_DIRTY;
 }
 
-void Chunk::GenerateSeam()
+void Chunk::GenerateSeamRegion(int region)
 {
-	vector<Octree *> nodes = FindSeamNodes();
+	SeamMesh &mesh = m_seamRegions[region];
+	mesh.vertices.clear();
+	mesh.indices.clear();
+
+	vector<Octree *> nodes = FindSeamNodes(region);
 	if (nodes.size() == 0) return;
 
-	Octree* root = BottomUpTreeGen(nodes, m_position);
+	LinearOctree seam;
+	seam.Build(nodes, m_position);
+	seam.SetSeamRegion(region, m_chunkSize * (float)m_voxelSize);
 
-	int currSize = m_vertices.size();
-	root->GenerateVertexBuffer(m_vertices);	
-	for (int i = currSize; i < m_vertices.size(); i++)
-		m_vertices[i].position -= m_position;
+	//seams only use leaf vertices, their neighbours may be releasing simplification data.
+	//boundary leaves are never simplified, so this chunk's leaves reuse their body vertices
+	const GLuint bodyCount = m_vertices.size();
+	vector<Vertex> vertices;
+	vector<GLuint> indices;
+	seam.GenerateSeamVertexBuffer(vertices, bodyCount);
+	seam.ProcessCell(indices, -1.f);
 
-	root->ProcessCell(m_triIndices, 1000.f);
+	//keep the neighbour vertices this region's triangles use, cells next to it only help the traversal
+	vector<int> remap(vertices.size(), -1);
+	for (GLuint index : indices)
+	{
+		if (index < bodyCount)
+		{
+			mesh.indices.push_back(index);
+			continue;
+		}
+
+		int &local = remap[index - bodyCount];
+		if (local < 0)
+		{
+			local = mesh.vertices.size();
+			mesh.vertices.push_back(vertices[index - bodyCount]);
+			mesh.vertices.back().pos -= m_position;
+		}
+		mesh.indices.push_back(bodyCount + local);
+	}
 }
 
 void Chunk::GenerateMesh()
@@ -226,30 +298,82 @@ void Chunk::GenerateMesh()
 	glm::vec3 gridSize = m_chunkSize + glm::vec3(1.0f);
 	float chunkMaxBound = m_position.y + m_chunkSize.y * m_voxelSize;
 
-	for (auto &values : m_nodeMap)
-	{
-		Octree *node = values.second;
-		FindEdgeCrossing(node, m_hermiteMap);
-		if (~node->m_flag & OCTREE_ACTIVE)
-			m_nodeMap.erase(values.first);
-	}
+	for (Octree *node : m_nodeGrid.GetNodes())
+		FindEdgeCrossing(node, m_hermite, m_arena, m_vertexDataArena);
+	m_nodeGrid.RemoveInactive();
 
-	m_root = BottomUpTreeGen(m_nodeMap, m_position);
+	QEFBatch batch;
+	SolveLeafVertices(m_nodeGrid.GetNodes(), batch);
 
-	if (m_root == nullptr)
+	m_octree.Build(m_nodeGrid.GetNodes(), m_position);
+
+	if (m_octree.IsEmpty())
 	{
 		m_flag = ~CHUNK_ACTIVE;
+		ReleaseBuildData();
 		return;
 	}
 	
 	m_flag |= CHUNK_ACTIVE;
 
 
-	//m_root->ClusterCellBase(2000000.f);
-	m_root->GenerateVertexBuffer(m_vertices);
-	for (int i = 0; i < m_vertices.size(); i++)
-		m_vertices[i].position -= m_position;
-	m_root->ProcessCell(m_triIndices, 2000000.f);
+	for (Octree *node : m_nodeGrid.GetNodes())
+		m_leafVertexCount += node->m_vertex_count;
+
+	//simplification only touches this chunk's arenas, so it runs inside the chunk job
+	if (m_lodError >= 0.f)
+		m_octree.ClusterCellBase(m_lodError, glm::ivec3(m_chunkSize), m_arena, m_vertexDataArena);
+
+	m_octree.GenerateVertexBuffer(m_vertices, m_lodError);
+	for (size_t i = 0; i < m_vertices.size(); i++)
+		m_vertices[i].pos -= m_position;
+	m_octree.ProcessCell(m_triIndices, m_lodError, VoxelManager::GetTaskScheduler());
+
+	ReleaseBuildData();
+}
+
+void Chunk::ReleaseBuildData()
+{
+	//seams only read leaf corners and hot vertex data from here on
+	for (Octree *node : m_nodeGrid.GetNodes())
+	{
+		for (int i = 0; i < node->m_vertex_count; i++)
+			node->m_vertices[i].data = nullptr;
+	}
+
+	m_octree.Clear();
+	m_vertexDataArena.Reset();
+	m_hermite.Reset();
+	m_occupancy.Reset();
+}
+
+void Chunk::SwapBuildData(ChunkBuildData &data)
+{
+	m_occupancy.Swap(data.occupancy);
+	m_hermite.Swap(data.hermite);
+	m_vertexDataArena.Swap(data.vertexDataArena);
+}
+
+void Chunk::Unload()
+{
+	ReleaseBuildData();
+	m_nodeGrid.Clear();
+	m_arena.Reset();
+
+	m_vertices.clear();
+	m_triIndices.clear();
+	m_seamVertices.clear();
+	m_seamIndices.clear();
+	for (int region = 0; region < SEAM_REGION_COUNT; region++)
+	{
+		m_seamRegions[region].vertices.clear();
+		m_seamRegions[region].indices.clear();
+	}
+
+	std::fill(std::begin(m_neighbors), std::end(m_neighbors), nullptr);
+	m_vbo = m_ebo = m_seamEbo = 0;
+	m_vboCapacity = 0;
+	m_flag = 0;
 }
 
 bool  Chunk::GenerateMaterialIndices()
@@ -259,11 +383,15 @@ bool  Chunk::GenerateMaterialIndices()
 	switch (m_terrainType)
 	{
 	case Density::Terrain:
-		Density::GenerateHeightMap(m_position, m_chunkSize, densityField);
-		active = Density::GenerateMaterialIndices(m_position, m_chunkSize, m_materialIndices, densityField);
+		//skip the 3D grid for chunks entirely above or below the surface, the heightmap
+		//generated for the test is reused for the grid
+		if (!Density::TerrainChunkHasSurface(m_position, m_chunkSize, (float)m_voxelSize, densityField))
+			return false;
+
+		active = Density::GenerateMaterialIndices(m_position, m_chunkSize, (float)m_voxelSize, m_occupancy, densityField);
 		break;
 	case Density::Cave:
-		Density::GenerateCaveIndices(m_position, m_chunkSize, m_materialIndices);
+		Density::GenerateCaveIndices(m_position, m_chunkSize, (float)m_voxelSize, m_occupancy);
 		break;
 	default:
 		break;
@@ -274,41 +402,28 @@ bool  Chunk::GenerateMaterialIndices()
 
 void Chunk::GenerateHermiteField()
 {
-	//loop through each voxel and calculate edge crossings
-	for (int x = 0; x <= m_chunkSize.x; x++)
+	vector<glm::ivec3> crossings;
+	vector<int> axes;
+	vector<glm::vec3> edgeStart, edgeEnd, intersections, normals;
+
+	//find every edge with a material change
+	m_occupancy.FindCrossingEdges(crossings, axes);
+
+	edgeStart.reserve(crossings.size());
+	edgeEnd.reserve(crossings.size());
+	for (size_t i = 0; i < crossings.size(); i++)
 	{
-		for (int y = 0; y <= m_chunkSize.y; y++)
-		{
-			for (int z = 0; z <= m_chunkSize.z; z++)
-			{
-				for (int axis = 0; axis < 3; axis++)
-				{
-					glm::ivec3 index2 = glm::vec3(x, y, z) + AXIS_OFFSET[axis];
-
-					if (GETINDEXCHUNK(glm::ivec3(m_chunkSize + glm::vec3(1.0f)), index2.x, index2.y, index2.z) > m_materialIndices.size())
-						continue;
-
-					int m1 = m_materialIndices[GETINDEXCHUNK(glm::ivec3(m_chunkSize + glm::vec3(1.0f)), x, y, z)];
-					int m2 = m_materialIndices[GETINDEXCHUNK(glm::ivec3(m_chunkSize + glm::vec3(1.0f)), index2.x, index2.y, index2.z)];
-
-					//no material change, no edge
-					if (m1 == m2)
-						continue;
-
-					glm::vec3 p1 = m_position + glm::vec3(x, y, z) * (float)m_voxelSize;
-					glm::vec3 p2 = m_position + (glm::vec3(x, y, z) + AXIS_OFFSET[axis]) * (float)m_voxelSize;
-
-					//get hermite data
-					glm::vec3 p = Density::FindIntersection(m_terrainType, p1, p2);
-					glm::vec3 n = Density::CalculateNormals(m_terrainType, p);
-
-					//store in map
-					EdgeInfo edge(p, n);
-					m_hermiteMap[(p1 + p2) *.5f] = edge;
-				}
-			}
-		}
+		edgeStart.push_back(m_position + glm::vec3(crossings[i]) * (float)m_voxelSize);
+		edgeEnd.push_back(m_position + (glm::vec3(crossings[i]) + AXIS_OFFSET[axes[i]]) * (float)m_voxelSize);
 	}
+
+	//get hermite data for every edge, one noise pass each for positions and normals
+	Density::FindIntersections(m_terrainType, edgeStart, edgeEnd, intersections);
+	Density::CalculateNormals(m_terrainType, intersections, normals);
+
+	m_hermite.Build(m_occupancy, m_position, m_voxelSize);
+	for (size_t i = 0; i < intersections.size(); i++)
+		m_hermite.SetEdge(crossings[i], axes[i], intersections[i], normals[i]);
 }
 
 void Chunk::GenerateHermiteHeightMap2D()
@@ -316,9 +431,9 @@ void Chunk::GenerateHermiteHeightMap2D()
 	float chunkMaxBound = m_position.y + m_chunkSize.y * m_voxelSize;
 	glm::ivec3 gridSize = m_chunkSize + glm::vec3(1.0f);
 
-	for (auto &values : m_nodeMap)
+	m_hermite.Build(m_occupancy, m_position, m_voxelSize);
+	for (Octree *node : m_nodeGrid.GetNodes())
 	{
-		Octree *node = values.second;
 		int corners = node->m_corners;
 
 		//find intersection for all 12 edges of the voxel
@@ -343,10 +458,7 @@ void Chunk::GenerateHermiteHeightMap2D()
 			glm::vec3 p = Density::FindIntersection2D(m_terrainType, p1, p2);
 			glm::vec3 n = Density::CalculateNormals2D(m_terrainType, p);
 
-			//store in map
-			EdgeInfo edge(p, n);
-			glm::vec3 edgePos = (p1 + p2) * .5f;
-			m_hermiteMap[(p1 + p2) *.5f] = edge;
+			m_hermite.SetEdge(m_hermite.GetLocalPosition(p1), edge_pairs[i][2], p, n);
 
 			edgeCount++;
 		}
@@ -360,10 +472,27 @@ void Chunk::SetBuffers(const GLuint vbo, const GLuint ebo)
 		LogToUnity("VBO & EBO passed in must not be 0");
 		return;
 	}
+
+	//new buffers need the body uploaded again
+	if (vbo != m_vbo || ebo != m_ebo)
+		m_flag &= ~CHUNK_BINDED;
 	m_vbo = vbo;
 	m_ebo = ebo;
 }
 
+void Chunk::SetSeamBuffer(const GLuint ebo)
+{
+	if (ebo == 0)
+	{
+		LogToUnity("Seam EBO passed in must not be 0");
+		return;
+	}
+
+	if (ebo != m_seamEbo)
+		m_flag |= SEAM_DIRTY;
+	m_seamEbo = ebo;
+}
+
 void Chunk::BindMesh()
 {
 	//ClearBufferedData();
@@ -379,22 +508,32 @@ void Chunk::BindMesh()
 		return;
 	}
 
-	vector<Vertex> vertices;
-	vertices.reserve(m_vertices.size());
-	
-	for (int i = 0; i < m_vertices.size(); i++)
+	//the body never changes once generated, re-seamed chunks only upload their seam.
+	//the seam's neighbour vertices follow the body in the same vbo, the body is only
+	//uploaded again when they outgrow the room left for them
+	const int vertexCount = m_vertices.size() + m_seamVertices.size();
+	if (!(m_flag & CHUNK_BINDED) || vertexCount > m_vboCapacity)
 	{
-		Vertex vert;
-		vert.pos = m_vertices[i].position;
-		vert.normal = m_vertices[i].normal;
-		vertices.push_back(vert);
+		m_vboCapacity = m_vertices.size() + glm::max(2 * (int)m_seamVertices.size(), CHUNK_SEAM_VERTEX_RESERVE);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_vboCapacity, nullptr, GL_STATIC_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_vertices.size(), &m_vertices[0]);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_triIndices.size(), &m_triIndices[0], GL_STATIC_DRAW);
+		m_flag |= CHUNK_BINDED | SEAM_DIRTY;
 	}
 
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER,sizeof(Vertex) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
+	if ((m_flag & SEAM_DIRTY) && m_seamEbo)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_vertices.size(), sizeof(Vertex) * m_seamVertices.size(), m_seamVertices.data());
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_triIndices.size(), &m_triIndices[0], GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_seamEbo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_seamIndices.size(), m_seamIndices.data(), GL_STATIC_DRAW);
+		m_flag &= ~SEAM_DIRTY;
+	}
 }
 
 int Chunk::GetVertexCount()
@@ -406,3 +545,38 @@ int Chunk::GetIndicesCount()
 {
 	return m_triIndices.size();
 }
+
+int Chunk::GetSeamIndicesCount()
+{
+	return m_seamIndices.size();
+}
+
+ChunkMeshStats Chunk::GetMeshStats()
+{
+	ChunkMeshStats stats;
+	stats.voxelSize = m_voxelSize;
+	stats.lodError = m_lodError;
+	stats.leafVertexCount = m_leafVertexCount;
+	stats.vertexCount = m_vertices.size();
+	stats.triangleCount = m_triIndices.size() / 3;
+	return stats;
+}
+
+size_t Chunk::GetMemoryUsage() const
+{
+	size_t total = m_arena.GetMemoryUsage() + m_vertexDataArena.GetMemoryUsage();
+	total += m_hermite.GetMemoryUsage() + m_occupancy.GetMemoryUsage() + m_nodeGrid.GetMemoryUsage();
+	total += (m_vertices.capacity() + m_seamVertices.capacity()) * sizeof(Vertex);
+	total += (m_triIndices.capacity() + m_seamIndices.capacity()) * sizeof(GLuint);
+	for (int region = 0; region < SEAM_REGION_COUNT; region++)
+	{
+		total += m_seamRegions[region].vertices.capacity() * sizeof(Vertex);
+		total += m_seamRegions[region].indices.capacity() * sizeof(GLuint);
+	}
+	return total;
+}
+
+size_t ChunkBuildData::GetMemoryUsage() const
+{
+	return occupancy.GetMemoryUsage() + hermite.GetMemoryUsage() + vertexDataArena.GetMemoryUsage();
+}
@@ -20,13 +20,66 @@ const glm::ivec3 g_neighbors[6] =
 	glm::ivec3(0,0,-1),
 	glm::ivec3(0,0, 1)
 };
+//seams between a chunk and its +x, +y and +z neighbours, bit i is set when the region crosses
+//the boundary along axis i. An edge of a face region lies on one boundary plane, an edge of an
+//edge region on the line where two of them meet. No dual edge crosses all three planes, so the
+//corner never needs a region of its own
+enum SeamRegion
+{
+	SEAM_RIGHT = 1,
+	SEAM_TOP = 2,
+	SEAM_TOP_RIGHT = 3,
+	SEAM_FRONT = 4,
+	SEAM_FRONT_RIGHT = 5,
+	SEAM_TOP_FRONT = 6,
+	SEAM_REGION_COUNT = 7
+};
+
+#define SEAM_ALL_REGIONS 0x7E //dirty bit of every region, bit r for region r
+
+//geometry of one seam region, positions relative to the chunk. Indices below the chunk's
+//body vertex count point at body vertices, the rest at the region's neighbour vertices
+struct SeamMesh
+{
+	vector<Vertex> vertices;
+	vector<GLuint> indices;
+};
+
+#define CHUNK_LOD_FULL_DETAIL_RANGE 1 //chunks this close to the player are never simplified
+#define CHUNK_LOD_ERROR 0.25f         //qef error allowed per voxel squared, grows with the square of the distance beyond that range
+#define CHUNK_LOD_RING_SIZE 2         //chunks per clipmap ring, the voxel size doubles with each ring out from the player
+#define CHUNK_LOD_MIN_CELLS 4         //the coarsest rings keep at least this many cells per axis
+
+//mesh size of a chunk after simplification, leafVertexCount is the full detail size
+struct ChunkMeshStats
+{
+	int voxelSize;  //world size of a cell, doubles with each lod ring
+	float lodError; //negative when the chunk kept full detail
+	int leafVertexCount;
+	int vertexCount;
+	int triangleCount;
+};
+
+//scratch a chunk only needs while it is generated. The pool lends it to each chunk for the
+//length of its Init, so its storage is reused instead of staying with every resident chunk
+struct ChunkBuildData
+{
+	OccupancyGrid occupancy;
+	HermiteGrid hermite;
+	MemoryArena vertexDataArena;
+
+	size_t GetMemoryUsage() const;
+};
+
 //for selection func
 typedef std::function<bool(const glm::ivec3&, const glm::ivec3&)> FilterNodesFunc;
 
 
 class Chunk
 {
-	Octree * m_root;
+	LinearOctree m_octree;
+	MemoryArena m_arena; //owns every node and vertex array of the chunk and its seam
+	MemoryArena m_vertexDataArena; //simplification data, released once the mesh is generated
 
 	int m_flag;
 
@@ -37,24 +90,52 @@ class Chunk
 
 	Density::DensityType m_terrainType;
 
+	float m_lodError;
+	int m_lodLevel; //clipmap ring the chunk was built for
+	int m_leafVertexCount;
+
+	SeamMesh m_seamRegions[SEAM_REGION_COUNT]; //indexed by SeamRegion, slot 0 is unused
+	int m_dirtySeamRegions;
+
 	//proc mesh
 	GLuint m_vao, m_vbo, m_ebo;
+	GLuint m_seamEbo;
+	int m_vboCapacity; //vertices the vbo was allocated for
 public:
 	Chunk *m_neighbors[7];
 	glm::ivec3 m_chunkIndex;	
 
-	unordered_map<glm::vec3, EdgeInfo> m_hermiteMap;
-	vector<int> m_materialIndices;
-	unordered_map<glm::vec3, Octree*> m_nodeMap;
+	HermiteGrid m_hermite;
+	OccupancyGrid m_occupancy;
+	NodeGrid m_nodeGrid;
 
-	vector<VoxelVertex> m_vertices;
+	vector<Vertex> m_vertices;
 	vector<GLuint> m_triIndices;
 	vector<GLboolean> m_flipVerts;
+
+	//the seam regions packed into one buffer, replaced every time a neighbour arrives,
+	//the body mesh above is left alone. Only neighbour leaf vertices are stored, they are
+	//uploaded after the body vertices and seam indices address both
+	vector<Vertex> m_seamVertices;
+	vector<GLuint> m_seamIndices;
 public:
 	Chunk();
 	~Chunk();
 
-	bool Init(glm::ivec3 chunkIndices, glm::vec3 chunkSize, Density::DensityType type, int voxelSize);
+	//lodError is the simplification error threshold, negative keeps full detail.
+	//lodLevel is the ring chunkSize and voxelSize were chosen for
+	bool Init(glm::ivec3 chunkIndices, glm::vec3 chunkSize, Density::DensityType type, int voxelSize, float lodError = -1.f, int lodLevel = 0);
+
+	//ring of a chunk the given number of chunks away from the player, the chunk keeps its world
+	//size with chunkSize >> lod cells of voxelSize << lod. Capped at the rings whose cells
+	//divide chunkSize
+	static int GetLodLevel(int chunkDistance, int chunkSize);
+
+	//ring the chunk was built for, it is rebuilt when the player moves it into another one
+	int GetLodLevel() const;
+
+	//error threshold for a chunk the given number of chunks away from the player
+	static float GetLodError(int chunkDistance, int voxelSize);
 	
 	void ClearBufferedData();
 
@@ -72,11 +153,30 @@ public:
 
 	void FindActiveVoxels();
 	
-	void GetNodesInRange(const Chunk * chunk, const glm::ivec3 minrange, const glm::ivec3 maxrange, vector<Octree*> &outputNodes);
-	vector<Octree*> FindSeamNodes();
+	//chunk sharing a seam region with this one, offset has one bit per axis like SeamRegion
+	Chunk *GetSeamNeighbor(int offset);
+	vector<Octree*> FindSeamNodes(int region);
+
+	//marks the regions a neighbour at this offset takes part in, every region starts out dirty
+	void MarkSeamDirty(const glm::ivec3 &neighborOffset);
+
+	//rebuilds only the dirty regions, then repacks the seam buffer
 	void GenerateSeam();	
+	void GenerateSeamRegion(int region);
 	void GenerateMesh();
 
+	//empties the density, hermite and simplification data once the mesh is generated,
+	//their storage is kept until SwapBuildData hands it back
+	void ReleaseBuildData();
+
+	//exchanges the chunk's build scratch with data, before Init to lend it and after to take it back
+	void SwapBuildData(ChunkBuildData &data);
+
+	//drops the meshes and leaves of a chunk that left the render range and forgets its
+	//buffers, they belong to unity and are released there. Vector, grid and arena capacity
+	//is kept for the next Init when the chunk is pooled
+	void Unload();
+
 	bool GenerateMaterialIndices();
 
 	void GenerateHermiteField();
@@ -85,9 +185,20 @@ public:
 
 	void SetBuffers(const GLuint vbo, const GLuint ebo);
 
+	//the seam is drawn from its own index buffer over the chunk's vbo
+	void SetSeamBuffer(const GLuint ebo);
+
+	//uploads the body once per buffer and the seam whenever it was regenerated
 	void BindMesh();
 	
 	int GetVertexCount();
 
 	int GetIndicesCount();
+
+	int GetSeamIndicesCount();
+
+	ChunkMeshStats GetMeshStats();
+
+	//bytes allocated by the chunk, including capacity kept for reuse
+	size_t GetMemoryUsage() const;
 };
\ No newline at end of file
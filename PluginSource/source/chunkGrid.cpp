@@ -0,0 +1,85 @@
+#include "VoxelPlugin.hpp"
+
+ChunkGrid::ChunkGrid() : m_size(1), m_halfSize(0), m_center(0)
+{
+
+}
+
+void ChunkGrid::Init(int halfSize, const glm::ivec3 &center)
+{
+	Clear();
+	m_halfSize = halfSize;
+	m_size = 2 * halfSize + 1;
+	m_center = center;
+	m_slots.assign(m_size * m_size * m_size, ChunkSlot());
+}
+
+void ChunkGrid::Recenter(const glm::ivec3 &center)
+{
+	if (center == m_center)
+		return;
+	m_center = center;
+
+	//a slot that left the window is free before any entry moving in needs it
+	for (ChunkSlot &slot : m_slots)
+	{
+		if (slot.used && !InWindow(slot.index))
+		{
+			m_overflow[slot.index] = slot;
+			slot = ChunkSlot();
+		}
+	}
+
+	for (auto iter = m_overflow.begin(); iter != m_overflow.end();)
+	{
+		if (InWindow(iter->first))
+		{
+			m_slots[GetSlot(iter->first)] = iter->second;
+			iter = m_overflow.erase(iter);
+		}
+		else
+			iter++;
+	}
+}
+
+ChunkSlot *ChunkGrid::Find(const glm::ivec3 &index)
+{
+	if (InWindow(index))
+	{
+		ChunkSlot &slot = m_slots[GetSlot(index)];
+		return slot.used ? &slot : nullptr;
+	}
+
+	if (m_overflow.empty())
+		return nullptr;
+
+	auto found = m_overflow.find(index);
+	return found != m_overflow.end() ? &found->second : nullptr;
+}
+
+ChunkSlot &ChunkGrid::Insert(const glm::ivec3 &index)
+{
+	ChunkSlot &slot = InWindow(index) ? m_slots[GetSlot(index)] : m_overflow[index];
+	if (!slot.used)
+	{
+		slot = ChunkSlot();
+		slot.index = index;
+		slot.used = true;
+	}
+	return slot;
+}
+
+void ChunkGrid::Erase(const glm::ivec3 &index)
+{
+	if (InWindow(index))
+		m_slots[GetSlot(index)] = ChunkSlot();
+	else
+		m_overflow.erase(index);
+}
+
+void ChunkGrid::Clear()
+{
+	for (ChunkSlot &slot : m_slots)
+		slot = ChunkSlot();
+	m_overflow.clear();
+}
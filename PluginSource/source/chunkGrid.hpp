@@ -0,0 +1,79 @@
+#pragma once
+
+//a chunk index known to the manager, queued is set from the moment it is queued for
+//generation and chunk once it is generated. rebuilding is set while a chunk for another
+//lod ring is generated to replace chunk
+struct ChunkSlot
+{
+	glm::ivec3 index;
+	Chunk *chunk;
+	bool queued;
+	bool rebuilding;
+	bool used;
+
+	ChunkSlot() : index(0), chunk(nullptr), queued(false), rebuilding(false), used(false) {}
+};
+
+//Toroidally addressed 3D array of chunk slots over a window of chunks around the player.
+//An index inside the window always lives in the slot given by its coordinates modulo the
+//window size, so lookups and neighbour probes are index arithmetic. Entries outside the
+//window, chunks kept past the range or requested far away, spill into a hash map that is
+//only searched while it holds anything
+class ChunkGrid
+{
+	int m_size; //slots per axis
+	int m_halfSize;
+	glm::ivec3 m_center;
+	vector<ChunkSlot> m_slots;
+	unordered_map<glm::ivec3, ChunkSlot> m_overflow;
+
+	inline int Wrap(int i) const { return ((i % m_size) + m_size) % m_size; }
+
+	inline int GetSlot(const glm::ivec3 &index) const { return (Wrap(index.x) * m_size + Wrap(index.y)) * m_size + Wrap(index.z); }
+
+	inline bool InWindow(const glm::ivec3 &index) const
+	{
+		const glm::ivec3 offset = glm::abs(index - m_center);
+		return glm::max(offset.x, glm::max(offset.y, offset.z)) <= m_halfSize;
+	}
+
+public:
+	ChunkGrid();
+
+	//window of halfSize chunks on each side of the center
+	void Init(int halfSize, const glm::ivec3 &center);
+
+	//moves the window, entries it left go to the overflow and entries it reached come back
+	void Recenter(const glm::ivec3 &center);
+
+	//null when the index was never added
+	ChunkSlot *Find(const glm::ivec3 &index);
+
+	inline Chunk *FindChunk(const glm::ivec3 &index)
+	{
+		ChunkSlot *slot = Find(index);
+		return slot ? slot->chunk : nullptr;
+	}
+
+	//returns the existing slot of the index or a new empty one
+	ChunkSlot &Insert(const glm::ivec3 &index);
+
+	void Erase(const glm::ivec3 &index);
+
+	//calls func on every used slot, the grid must not be changed meanwhile
+	template<typename F>
+	void ForEach(F func)
+	{
+		for (ChunkSlot &slot : m_slots)
+		{
+			if (slot.used)
+				func(slot);
+		}
+		for (auto &value : m_overflow)
+			func(value.second);
+	}
+
+	inline int GetOverflowCount() const { return m_overflow.size(); }
+
+	void Clear();
+};
@@ -0,0 +1,121 @@
+#include "VoxelPlugin.hpp"
+
+ChunkPool::ChunkPool(size_t capacity) : m_capacity(capacity)
+{
+
+}
+
+ChunkPool::~ChunkPool()
+{
+	Clear();
+}
+
+void ChunkPool::SetCapacity(size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_capacity = capacity;
+
+	while (m_chunks.size() > m_capacity)
+	{
+		delete m_chunks.back();
+		m_chunks.pop_back();
+	}
+}
+
+Chunk *ChunkPool::Acquire()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (!m_chunks.empty())
+		{
+			Chunk *chunk = m_chunks.back();
+			m_chunks.pop_back();
+			return chunk;
+		}
+	}
+
+	return new Chunk();
+}
+
+void ChunkPool::Release(Chunk *chunk)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (m_chunks.size() < m_capacity)
+		{
+			m_chunks.push_back(chunk);
+			return;
+		}
+	}
+
+	delete chunk;
+}
+
+ChunkBuildData *ChunkPool::AcquireBuildData()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (!m_buildData.empty())
+		{
+			ChunkBuildData *data = m_buildData.back();
+			m_buildData.pop_back();
+			return data;
+		}
+	}
+
+	return new ChunkBuildData();
+}
+
+void ChunkPool::ReleaseBuildData(ChunkBuildData *data)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_buildData.push_back(data);
+}
+
+size_t ChunkPool::GetMemoryUsage()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	size_t total = 0;
+	for (Chunk *chunk : m_chunks)
+		total += chunk->GetMemoryUsage();
+	for (ChunkBuildData *data : m_buildData)
+		total += data->GetMemoryUsage();
+	return total;
+}
+
+void ChunkPool::Trim(size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	size_t total = 0;
+	for (Chunk *chunk : m_chunks)
+		total += chunk->GetMemoryUsage();
+	for (ChunkBuildData *data : m_buildData)
+		total += data->GetMemoryUsage();
+
+	//chunks go first, the scratch is needed by the next generation either way
+	while (total > bytes && !m_chunks.empty())
+	{
+		total -= m_chunks.back()->GetMemoryUsage();
+		delete m_chunks.back();
+		m_chunks.pop_back();
+	}
+	while (total > bytes && !m_buildData.empty())
+	{
+		total -= m_buildData.back()->GetMemoryUsage();
+		delete m_buildData.back();
+		m_buildData.pop_back();
+	}
+}
+
+void ChunkPool::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	for (Chunk *chunk : m_chunks)
+		delete chunk;
+	m_chunks.clear();
+	for (ChunkBuildData *data : m_buildData)
+		delete data;
+	m_buildData.clear();
+}
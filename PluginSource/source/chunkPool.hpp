@@ -0,0 +1,42 @@
+#pragma once
+
+#define CHUNK_POOL_CAPACITY 64 //unloaded chunks kept for reuse, the rest are deleted
+
+//Thread safe free list of unloaded chunks. They keep the capacity of their vectors, grids and
+//arena, so chunks streamed in reuse the memory of chunks streamed out instead of growing the heap.
+//The build scratch is pooled on its own, one set per chunk being generated at a time
+class ChunkPool
+{
+	std::mutex m_lock;
+	vector<Chunk*> m_chunks;
+	vector<ChunkBuildData*> m_buildData;
+	size_t m_capacity;
+
+	ChunkPool(const ChunkPool &);
+	ChunkPool &operator=(const ChunkPool &);
+
+public:
+	ChunkPool(size_t capacity = CHUNK_POOL_CAPACITY);
+	~ChunkPool();
+
+	void SetCapacity(size_t capacity);
+
+	//a pooled chunk, or a new one when the pool is empty
+	Chunk *Acquire();
+
+	//the chunk must be unloaded and unlinked, it is deleted when the pool is full
+	void Release(Chunk *chunk);
+
+	//build scratch left by an earlier generation, or a new one when none is free
+	ChunkBuildData *AcquireBuildData();
+
+	void ReleaseBuildData(ChunkBuildData *data);
+
+	//bytes held by the pooled chunks and build scratch
+	size_t GetMemoryUsage();
+
+	//deletes pooled chunks until the pool holds at most bytes, build scratch in use is not counted
+	void Trim(size_t bytes);
+
+	void Clear();
+};
@@ -0,0 +1,82 @@
+#include "VoxelPlugin.hpp"
+
+ChunkQueue::ChunkQueue() : m_playerChunkIndex(0), m_viewDirection(0.f)
+{
+
+}
+
+float ChunkQueue::GetPriority(const glm::ivec3 &index) const
+{
+	const glm::vec3 offset = glm::vec3(index - m_playerChunkIndex);
+	const float distance = glm::length(offset);
+	if (distance == 0.f)
+		return 0.f;
+
+	//facing is 0 without a view direction, which leaves plain distance order
+	const float facing = glm::dot(offset / distance, m_viewDirection);
+	return distance * (1.f + CHUNK_QUEUE_VIEW_WEIGHT * 0.5f * (1.f - facing));
+}
+
+void ChunkQueue::Push(const glm::ivec3 &index)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	Entry entry;
+	entry.index = index;
+	entry.priority = GetPriority(index);
+	m_heap.push_back(entry);
+	std::push_heap(m_heap.begin(), m_heap.end(), EntryCompare());
+}
+
+bool ChunkQueue::Pop(glm::ivec3 &index, glm::ivec3 &playerChunkIndex)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (m_heap.empty())
+		return false;
+
+	std::pop_heap(m_heap.begin(), m_heap.end(), EntryCompare());
+	index = m_heap.back().index;
+	playerChunkIndex = m_playerChunkIndex;
+	m_heap.pop_back();
+	return true;
+}
+
+void ChunkQueue::SetFocus(const glm::ivec3 &playerChunkIndex, const glm::vec3 &viewDirection)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_playerChunkIndex = playerChunkIndex;
+	m_viewDirection = viewDirection;
+
+	for (Entry &entry : m_heap)
+		entry.priority = GetPriority(entry.index);
+	std::make_heap(m_heap.begin(), m_heap.end(), EntryCompare());
+}
+
+void ChunkQueue::Cancel(int range, vector<glm::ivec3> &cancelled)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	int kept = 0;
+	for (size_t i = 0; i < m_heap.size(); i++)
+	{
+		const glm::ivec3 offset = glm::abs(m_heap[i].index - m_playerChunkIndex);
+		if (glm::max(offset.x, glm::max(offset.y, offset.z)) > range)
+			cancelled.push_back(m_heap[i].index);
+		else
+			m_heap[kept++] = m_heap[i];
+	}
+	m_heap.resize(kept);
+	std::make_heap(m_heap.begin(), m_heap.end(), EntryCompare());
+}
+
+int ChunkQueue::GetCount()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_heap.size();
+}
+
+void ChunkQueue::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_heap.clear();
+}
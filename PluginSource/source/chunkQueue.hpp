@@ -0,0 +1,45 @@
+#pragma once
+
+#define CHUNK_QUEUE_VIEW_WEIGHT 1.f //a chunk straight behind the view counts as this much farther again than one straight ahead
+
+//Thread safe queue of chunks waiting to be generated, the nearest chunk to the player is popped
+//first. With a view direction set, chunks in front of the player are preferred over those behind
+class ChunkQueue
+{
+	struct Entry
+	{
+		glm::ivec3 index;
+		float priority;
+	};
+
+	//min heap on priority
+	struct EntryCompare
+	{
+		inline bool operator()(const Entry &a, const Entry &b) const { return a.priority > b.priority; }
+	};
+
+	std::mutex m_lock;
+	vector<Entry> m_heap;
+	glm::ivec3 m_playerChunkIndex;
+	glm::vec3 m_viewDirection;
+
+	float GetPriority(const glm::ivec3 &index) const;
+
+public:
+	ChunkQueue();
+
+	void Push(const glm::ivec3 &index);
+
+	//returns false when empty, playerChunkIndex is the player chunk at the time of the pop
+	bool Pop(glm::ivec3 &index, glm::ivec3 &playerChunkIndex);
+
+	//reorders the queue around a new player chunk, viewDirection is normalized or zero
+	void SetFocus(const glm::ivec3 &playerChunkIndex, const glm::vec3 &viewDirection);
+
+	//drops the chunks further than range chunks from the player and returns their indices
+	void Cancel(int range, vector<glm::ivec3> &cancelled);
+
+	int GetCount();
+
+	void Clear();
+};
@@ -3,6 +3,8 @@ float Density::voxelSize = 32.0f;
 float Density::invVoxelSize = 1.0f;
 float Density::maxHeight = 32.0f; //max number of voxels high
 float Density::noiseScale;
+int Density::chunkSize = 0;
+HeightMapCache Density::heightMapCache;
 float Density::densityGenTime;
 
 FastNoise Density::terrainFN;
@@ -24,10 +26,23 @@ void Density::SetMaxVoxelHeight(const float & height)
 	Density::maxHeight = height;
 }
 
+void Density::SetChunkSize(const int & chunkSize)
+{
+	//heightmap tiles are one chunk wide
+	Density::chunkSize = chunkSize;
+	heightMapCache.Clear();
+}
+
+void Density::SetHeightMapCacheCapacity(size_t tiles)
+{
+	heightMapCache.SetCapacity(tiles);
+}
+
 void Density::Initialize()
 {
 	omp_init_lock(&g_thread_lock);
 	noiseScale = 0.3f;
+	heightMapCache.Clear();
 
 	terrainFN.SetFractalOctaves(10);
 	terrainFN.SetFrequency(0.01f);
@@ -86,6 +101,62 @@ glm::vec3 Density::FindIntersection(Density::DensityType type, const glm::vec3 &
 	return p0 + ((p1 - p0) * t);
 }
 
+//batched version of FindIntersection. Every edge is sampled at the same 9 steps but all samples
+//go through a single FillNoiseSet call so the SIMD noise runs at full width
+void Density::FindIntersections(Density::DensityType type, const vector<glm::vec3> &p0, const vector<glm::vec3> &p1, vector<glm::vec3> &intersections)
+{
+	const int steps = 8;
+	const int samples = steps + 1;
+	const float increment = 1.f / (float)steps;
+	const int edgeCount = p0.size();
+
+	intersections.resize(edgeCount);
+	if (edgeCount == 0) return;
+
+	FastNoiseVectorSet positionSet(edgeCount * samples);
+	float *set = FastNoiseSIMD::GetEmptySet(positionSet.size);
+
+	for (int e = 0; e < edgeCount; e++)
+	{
+		const glm::vec3 start = p0[e] * invVoxelSize;
+		const glm::vec3 delta = (p1[e] - p0[e]) * invVoxelSize;
+		float currentT = 0.f;
+
+		for (int i = 0; i < samples; i++)
+		{
+			const int index = e * samples + i;
+			positionSet.xSet[index] = start.x + delta.x * currentT;
+			positionSet.ySet[index] = start.y + delta.y * currentT;
+			positionSet.zSet[index] = start.z + delta.z * currentT;
+			currentT += increment;
+		}
+	}
+
+	FillDensitySet(type, set, positionSet);
+
+	for (int e = 0; e < edgeCount; e++)
+	{
+		const float *edgeSet = set + e * samples;
+		float minValue = 100000.f;
+		float t = 0.f;
+
+		for (int i = 0; i < samples; i++)
+		{
+			float density = glm::abs(edgeSet[i]);
+			if (density < minValue)
+			{
+				minValue = density;
+				t = increment * i;
+			}
+		}
+
+		intersections[e] = p0[e] + ((p1[e] - p0[e]) * t);
+	}
+
+	FastNoiseSIMD::FreeNoiseSet(set);
+	positionSet.Free();
+}
+
 glm::vec3 Density::FindIntersection2D(Density::DensityType type, const glm::vec3 &p0, const glm::vec3 &p1)
 {
 	float minValue = 100000.f;
@@ -100,9 +171,15 @@ glm::vec3 Density::FindIntersection2D(Density::DensityType type, const glm::vec3
 		positions[i] = p0 + ((p1 - p0) * currentT);
 		currentT += increment;
 	}
+
+	//vertical edges share one column of the heightmap
+	float height;
+	bool verticalEdge = type == Terrain && p0.x == p1.x && p0.z == p1.z && GetCachedHeight(p0, height);
+
 	for (int i = 0; i <= steps; i++)
 	{
-		float density = glm::abs(Density::GetNoise2D(type, positions[i]));
+		float noise = verticalEdge ? positions[i].y - height : Density::GetNoise2D(type, positions[i]);
+		float density = glm::abs(noise);
 		if (density < minValue)
 		{
 			minValue = density;
@@ -137,6 +214,56 @@ glm::vec3 Density::CalculateNormals(Density::DensityType type, const glm::vec3 &
 	return glm::normalize(d1 - d2);
 }
 
+//batched version of CalculateNormals. The six finite difference taps of every position
+//are gathered into one set so all gradients come out of a single SIMD noise sweep
+void Density::CalculateNormals(Density::DensityType type, const vector<glm::vec3> &positions, vector<glm::vec3> &normals)
+{
+	const float H = 0.1f;
+	const int taps = 6;
+	const glm::vec3 offsets[taps] =
+	{
+		glm::vec3(H, 0.f, 0.f),
+		glm::vec3(0.f, H, 0.f),
+		glm::vec3(0.f, 0.f, H),
+		glm::vec3(-H, 0.f, 0.f),
+		glm::vec3(0.f, -H, 0.f),
+		glm::vec3(0.f, 0.f, -H)
+	};
+	const int count = positions.size();
+
+	normals.resize(count);
+	if (count == 0) return;
+
+	FastNoiseVectorSet positionSet(count * taps);
+	float *set = FastNoiseSIMD::GetEmptySet(positionSet.size);
+
+	for (int p = 0; p < count; p++)
+	{
+		for (int i = 0; i < taps; i++)
+		{
+			const int index = p * taps + i;
+			const glm::vec3 tap = positions[p] + offsets[i];
+			positionSet.xSet[index] = tap.x * invVoxelSize;
+			positionSet.ySet[index] = tap.y * invVoxelSize;
+			positionSet.zSet[index] = tap.z * invVoxelSize;
+		}
+	}
+
+	FillDensitySet(type, set, positionSet);
+
+	for (int p = 0; p < count; p++)
+	{
+		const float *tapSet = set + p * taps;
+		glm::vec3 d1(tapSet[0], tapSet[1], tapSet[2]);
+		glm::vec3 d2(tapSet[3], tapSet[4], tapSet[5]);
+
+		normals[p] = glm::normalize(d1 - d2);
+	}
+
+	FastNoiseSIMD::FreeNoiseSet(set);
+	positionSet.Free();
+}
+
 glm::vec3 Density::CalculateNormals2D(Density::DensityType type, const glm::vec3 &pos)
 {
 	const float H = 0.1f;
@@ -146,6 +273,17 @@ glm::vec3 Density::CalculateNormals2D(Density::DensityType type, const glm::vec3
 		return glm::vec3(0.0f, 1.0f, 0.0f);
 	}
 
+	//the heightmap does not vary along y, so the y taps share a single height sample
+	if (type == Terrain)
+	{
+		const float height = GetHeight2D(type, pos);
+		const float dx = GetNoise2D(type, pos + glm::vec3(H, 0.f, 0.f)) - GetNoise2D(type, pos - glm::vec3(H, 0.f, 0.f));
+		const float dy = ((pos.y + H) - height) - ((pos.y - H) - height);
+		const float dz = GetNoise2D(type, pos + glm::vec3(0.f, 0.f, H)) - GetNoise2D(type, pos - glm::vec3(0.f, 0.f, H));
+
+		return glm::normalize(glm::vec3(dx, dy, dz));
+	}
+
 	//finite difference method to get partial derivatives
 	const float dx = GetNoise2D(type, pos + glm::vec3(H, 0.f, 0.f)) - GetNoise2D(type, pos - glm::vec3(H, 0.f, 0.f));
 	const float dy = GetNoise2D(type, pos + glm::vec3(0.f, H, 0.f)) - GetNoise2D(type, pos - glm::vec3(0.f, H, 0.f));
@@ -204,12 +342,20 @@ float Density::GetDensity(DensityType type, const glm::vec3 & worldPosition)
 }
 
 float Density::GetNoise2D(DensityType type, const glm::vec3 & worldPosition)
+{
+	return worldPosition.y - GetHeight2D(type, worldPosition);
+}
+
+//height of the 2D noise surface in world space
+float Density::GetHeight2D(DensityType type, const glm::vec3 & worldPosition)
 {
 	glm::vec3 voxelPos = worldPosition * invVoxelSize * noiseScale;
 	float height;
 	switch (type)
 	{
 	case Terrain:
+		if (GetCachedHeight(worldPosition, height))
+			break;
 		height = terrainFN.GetSimplexFractal(voxelPos.x, voxelPos.z) * maxHeight * voxelSize; //convert to world Position
 		break;
 	case Cave:
@@ -219,7 +365,7 @@ float Density::GetNoise2D(DensityType type, const glm::vec3 & worldPosition)
 		break;
 	}	
 
-	return worldPosition.y - height;
+	return height;
 }
 
 float *Density::GetDensitySet(DensityType type, const vector<glm::vec3> & positions)
@@ -228,7 +374,7 @@ float *Density::GetDensitySet(DensityType type, const vector<glm::vec3> & positi
 	float *set = FastNoiseSIMD::GetEmptySet(positions.size());
 	FastNoiseVectorSet positionSet(positions.size());
 
-	for (int i = 0; i < positions.size(); i++)
+	for (size_t i = 0; i < positions.size(); i++)
 	{
 		positionSet.xSet[i] = positions[i].x * invVoxelSize;
 		positionSet.ySet[i] = positions[i].y * invVoxelSize;
@@ -240,7 +386,7 @@ float *Density::GetDensitySet(DensityType type, const vector<glm::vec3> & positi
 	case Terrain:
 	{
 		terrainFNSIMD->FillNoiseSet(set, &positionSet);
-		for (int i = 0; i < positions.size(); i++)
+		for (size_t i = 0; i < positions.size(); i++)
 		{
 			set[i] = GetTerrainDensity(positions[i], set[i], set[i] * .7989);
 		}
@@ -258,6 +404,29 @@ float *Density::GetDensitySet(DensityType type, const vector<glm::vec3> & positi
 	return set;
 }
 
+//positionSet is expected in voxel space
+void Density::FillDensitySet(DensityType type, float *set, FastNoiseVectorSet &positionSet)
+{
+	switch (type)
+	{
+	case Terrain:
+	{
+		terrainFNSIMD->FillNoiseSet(set, &positionSet);
+		for (int i = 0; i < positionSet.size; i++)
+		{
+			glm::vec3 worldPosition = glm::vec3(positionSet.xSet[i], positionSet.ySet[i], positionSet.zSet[i]) * voxelSize;
+			set[i] = GetTerrainDensity(worldPosition, set[i], set[i] * .7989);
+		}
+		break;
+	}
+	case Cave:
+		caveFNSIMD->FillNoiseSet(set, &positionSet);
+		break;
+	default:
+		break;
+	}
+}
+
 void Density::FreeSet(float *set)
 {
 	FastNoiseSIMD::FreeNoiseSet(set);
@@ -276,14 +445,16 @@ float Density::GetCaveNoise(glm::vec3 worldPosition)
 	return noise;
 }
 
-void Density::GenerateTerrainIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, vector<int> &materialIndices)
+void Density::GenerateTerrainIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, OccupancyGrid &occupancy)
 {
-	materialIndices.resize((chunkSize.x + 1) *  (chunkSize.y + 1) * (chunkSize.z + 1), -1);
+	occupancy.Resize(glm::ivec3(chunkSize + glm::vec3(1.0f)));
 	
-	glm::vec3 voxelPos = glm::ivec3(chunkPos * invVoxelSize);
+	//lod chunks sample every step-th voxel, the scale modifier keeps the noise frequency in voxel space
+	const int step = (int)(cellSize * invVoxelSize);
+	glm::ivec3 setStart = glm::ivec3(chunkPos * invVoxelSize) / step;
 	glm::vec3 setSize = chunkSize + glm::vec3(1.0f);
 	
-	float *noiseSet = terrainFNSIMD->GetNoiseSet(voxelPos.x, voxelPos.y, voxelPos.z, setSize.x, setSize.y, setSize.z);
+	float *noiseSet = terrainFNSIMD->GetNoiseSet(setStart.x, setStart.y, setStart.z, setSize.x, setSize.y, setSize.z, (float)step);
 	
 	for (int x = 0; x <= chunkSize.x; x++)
 	{
@@ -292,10 +463,11 @@ void Density::GenerateTerrainIndices(const glm::vec3 &chunkPos, const glm::vec3
 			for (int z = 0; z <= chunkSize.z; z++)
 			{
 				int index = GETINDEXCHUNK(glm::ivec3(chunkSize + glm::vec3(1.0f)), x, y, z);
-				glm::vec3 worldPosition = chunkPos + glm::vec3(x, y, z) * voxelSize;
+				glm::vec3 worldPosition = chunkPos + glm::vec3(x, y, z) * cellSize;
 				
 				float density = GetTerrainDensity(worldPosition, noiseSet[index], noiseSet[index] * .7989);
-				materialIndices[index] = density > 0 ? MATERIAL_AIR : MATERIAL_SOLID;
+				if (density <= 0)
+					occupancy.SetSolid(x, y, z);
 			}
 		}
 	}
@@ -303,14 +475,15 @@ void Density::GenerateTerrainIndices(const glm::vec3 &chunkPos, const glm::vec3
 	FastNoiseSIMD::FreeNoiseSet(noiseSet);
 }
 
-void Density::GenerateCaveIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, vector<int> &materialIndices)
+void Density::GenerateCaveIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, OccupancyGrid &occupancy)
 {
-	materialIndices.resize((chunkSize.x + 1) *  (chunkSize.y + 1) * (chunkSize.z + 1), -1);
+	occupancy.Resize(glm::ivec3(chunkSize + glm::vec3(1.0f)));
 
-	glm::vec3 voxelPos = chunkPos * invVoxelSize;
+	const int step = (int)(cellSize * invVoxelSize);
+	glm::ivec3 setStart = glm::ivec3(chunkPos * invVoxelSize) / step;
 	glm::vec3 setSize = chunkSize + glm::vec3(1.0f);
 
-	float *noiseSet = caveFNSIMD->GetNoiseSet(voxelPos.x, voxelPos.y, voxelPos.z, setSize.x, setSize.y, setSize.z);
+	float *noiseSet = caveFNSIMD->GetNoiseSet(setStart.x, setStart.y, setStart.z, setSize.x, setSize.y, setSize.z, (float)step);
 	float caveThreshold = 0.75f;
 
 	for (int x = 0; x <= chunkSize.x; x++)
@@ -320,7 +493,8 @@ void Density::GenerateCaveIndices(const glm::vec3 &chunkPos, const glm::vec3 &ch
 			for (int z = 0; z <= chunkSize.z; z++)
 			{
 				int index = GETINDEXCHUNK(glm::ivec3(chunkSize + glm::vec3(1.0f)), x, y, z);				
-				materialIndices[index] = noiseSet[index] > caveThreshold ? MATERIAL_AIR : MATERIAL_SOLID;
+				if (noiseSet[index] <= caveThreshold)
+					occupancy.SetSolid(x, y, z);
 			}
 		}
 	}
@@ -328,15 +502,15 @@ void Density::GenerateCaveIndices(const glm::vec3 &chunkPos, const glm::vec3 &ch
 	FastNoiseSIMD::FreeNoiseSet(noiseSet);
 }
 
-void Density::GenerateMaterialIndices(DensityType type, const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, vector<int> &materialIndices)
+void Density::GenerateMaterialIndices(DensityType type, const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, OccupancyGrid &occupancy)
 {
 	switch (type)
 	{
 	case Terrain:
-		GenerateTerrainIndices(chunkPos, chunkSize, materialIndices);
+		GenerateTerrainIndices(chunkPos, chunkSize, cellSize, occupancy);
 		break;
 	case Cave:
-		GenerateCaveIndices(chunkPos, chunkSize, materialIndices);
+		GenerateCaveIndices(chunkPos, chunkSize, cellSize, occupancy);
 		break;
 	default:
 		break;
@@ -344,34 +518,183 @@ void Density::GenerateMaterialIndices(DensityType type, const glm::vec3 &chunkPo
 }
 
 //2D heightmap noise
-void Density::GenerateHeightMap(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, vector<float> &heightMap)
+void Density::GenerateHeightMap(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, vector<float> &heightMap)
 {
-	heightMap.resize((chunkSize.x + 1) * (chunkSize.z + 1), -696969.69696969);
-	glm::vec3 voxelPos = glm::ivec3(chunkPos * invVoxelSize);
-	//voxelPos *= noiseScale;
+	const int xSize = chunkSize.x + 1;
+	const int zSize = chunkSize.z + 1;
+	const int count = xSize * zSize;
+	heightMap.resize(count, -696969.69696969);
+	glm::ivec3 voxelPos = glm::ivec3(chunkPos * invVoxelSize);
+	const int step = (int)(cellSize * invVoxelSize);
+
+	//chunks stacked in the same column share one cached tile
+	if (Density::chunkSize > 0 && step == 1 && chunkSize.x == Density::chunkSize && chunkSize.z == Density::chunkSize &&
+		voxelPos.x % Density::chunkSize == 0 && voxelPos.z % Density::chunkSize == 0)
+	{
+		glm::ivec2 tileIndex = glm::ivec2(voxelPos.x, voxelPos.z) / Density::chunkSize;
+		HeightMapCache::Tile tile = GetHeightMapTile(tileIndex);
 
-	//set heightmap
-	for (int x = 0; x <= chunkSize.x; x++)
+		for (int i = 0; i < count; i++)
+			heightMap[i] = glm::max((*tile)[i], 1.0f);
+
+		return;
+	}
+
+	//lay out every column's sample position so the whole heightmap is filled in one set
+	vector<float> xSet(count), zSet(count);
+	for (int x = 0; x < xSize; x++)
 	{
-		for (int z = 0; z <= chunkSize.z; z++)
-		{ 
+		for (int z = 0; z < zSize; z++)
+		{
 			int index = GETINDEXCHUNKXZ(glm::ivec3(chunkSize + glm::vec3(1.0f)), x, z);
-			float height = terrainFN.GetSimplexFractal(noiseScale * (voxelPos.x + x), noiseScale * (voxelPos.z + z));
-			height = (height * maxHeight * voxelSize);//convert to world Position
-			height = glm::max(height, 1.0f);
-			heightMap[index] = height;
+			xSet[index] = noiseScale * (voxelPos.x + x * step);
+			zSet[index] = noiseScale * (voxelPos.z + z * step);
 		}
 	}
+
+	terrainFN.FillSimplexFractalSet(&heightMap[0], &xSet[0], &zSet[0], count);
+
+	//set heightmap
+	for (int i = 0; i < count; i++)
+	{
+		float height = (heightMap[i] * maxHeight * voxelSize);//convert to world Position
+		heightMap[i] = glm::max(height, 1.0f);
+	}
+}
+
+//returns the unclamped world space heights of a chunk column, generating and caching them if needed
+HeightMapCache::Tile Density::GetHeightMapTile(const glm::ivec2 &tileIndex)
+{
+	HeightMapCache::Tile tile = heightMapCache.Find(tileIndex);
+	if (tile) return tile;
+
+	const glm::ivec2 gridSize(chunkSize + 1);
+	const int count = gridSize.x * gridSize.y;
+	const glm::ivec2 voxelPos = tileIndex * chunkSize;
+
+	std::shared_ptr<vector<float>> heights = std::make_shared<vector<float>>(count);
+	vector<char> known(count, 0);
+
+	//adjacent tiles share their border row, copy it from any cached neighbour
+	HeightMapCache::Tile neighbor;
+	if ((neighbor = heightMapCache.Find(tileIndex + glm::ivec2(-1, 0))))
+	{
+		for (int z = 0; z <= chunkSize; z++)
+		{
+			(*heights)[GETINDEXCHUNKXZ(gridSize, 0, z)] = (*neighbor)[GETINDEXCHUNKXZ(gridSize, chunkSize, z)];
+			known[GETINDEXCHUNKXZ(gridSize, 0, z)] = 1;
+		}
+	}
+	if ((neighbor = heightMapCache.Find(tileIndex + glm::ivec2(1, 0))))
+	{
+		for (int z = 0; z <= chunkSize; z++)
+		{
+			(*heights)[GETINDEXCHUNKXZ(gridSize, chunkSize, z)] = (*neighbor)[GETINDEXCHUNKXZ(gridSize, 0, z)];
+			known[GETINDEXCHUNKXZ(gridSize, chunkSize, z)] = 1;
+		}
+	}
+	if ((neighbor = heightMapCache.Find(tileIndex + glm::ivec2(0, -1))))
+	{
+		for (int x = 0; x <= chunkSize; x++)
+		{
+			(*heights)[GETINDEXCHUNKXZ(gridSize, x, 0)] = (*neighbor)[GETINDEXCHUNKXZ(gridSize, x, chunkSize)];
+			known[GETINDEXCHUNKXZ(gridSize, x, 0)] = 1;
+		}
+	}
+	if ((neighbor = heightMapCache.Find(tileIndex + glm::ivec2(0, 1))))
+	{
+		for (int x = 0; x <= chunkSize; x++)
+		{
+			(*heights)[GETINDEXCHUNKXZ(gridSize, x, chunkSize)] = (*neighbor)[GETINDEXCHUNKXZ(gridSize, x, 0)];
+			known[GETINDEXCHUNKXZ(gridSize, x, chunkSize)] = 1;
+		}
+	}
+
+	//fill the remaining columns in one set
+	vector<int> indices;
+	vector<float> xSet, zSet;
+	indices.reserve(count);
+	xSet.reserve(count);
+	zSet.reserve(count);
+	for (int x = 0; x <= chunkSize; x++)
+	{
+		for (int z = 0; z <= chunkSize; z++)
+		{
+			int index = GETINDEXCHUNKXZ(gridSize, x, z);
+			if (known[index]) continue;
+
+			indices.push_back(index);
+			xSet.push_back(noiseScale * (float)(voxelPos.x + x));
+			zSet.push_back(noiseScale * (float)(voxelPos.y + z));
+		}
+	}
+
+	if (indices.size() > 0)
+	{
+		vector<float> noiseSet(indices.size());
+		terrainFN.FillSimplexFractalSet(&noiseSet[0], &xSet[0], &zSet[0], indices.size());
+
+		for (size_t i = 0; i < indices.size(); i++)
+			(*heights)[indices[i]] = noiseSet[i] * maxHeight * voxelSize; //convert to world Position
+	}
+
+	return heightMapCache.Insert(tileIndex, heights);
+}
+
+//looks up the height of a voxel aligned column in the heightmap cache, a miss generates and caches
+//the whole tile of its chunk column so the neighbouring columns hit
+bool Density::GetCachedHeight(const glm::vec3 &worldPosition, float &height)
+{
+	if (chunkSize <= 0) return false;
+
+	const float voxelX = worldPosition.x * invVoxelSize;
+	const float voxelZ = worldPosition.z * invVoxelSize;
+	if (voxelX != glm::floor(voxelX) || voxelZ != glm::floor(voxelZ))
+		return false;
+
+	const glm::ivec2 voxel(voxelX, voxelZ);
+	const glm::ivec2 tileIndex(glm::floor(glm::vec2(voxel) / (float)chunkSize));
+	HeightMapCache::Tile tile = GetHeightMapTile(tileIndex);
+
+	const glm::ivec2 local = voxel - tileIndex * chunkSize;
+	height = (*tile)[GETINDEXCHUNKXZ(glm::ivec2(chunkSize + 1), local.x, local.y)];
+	return true;
+}
+
+//classifies a terrain chunk from its column's heightmap range without touching the 3D grid
+//returns false if the chunk is entirely above or below the surface, heightMap is left filled
+//for GenerateMaterialIndices whenever the heightmap had to be generated
+bool Density::TerrainChunkHasSurface(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, vector<float> &heightMap)
+{
+	const float chunkMinY = chunkPos.y;
+	const float chunkMaxY = chunkPos.y + chunkSize.y * cellSize;
+
+	//fractal noise is normalized to [-1, 1] and the heightmap is clamped to at least 1
+	if (chunkMinY > maxHeight * voxelSize || chunkMaxY <= 1.0f)
+		return false;
+
+	GenerateHeightMap(chunkPos, chunkSize, cellSize, heightMap);
+
+	float lowest = heightMap[0];
+	float highest = heightMap[0];
+	for (size_t i = 1; i < heightMap.size(); i++)
+	{
+		lowest = glm::min(lowest, heightMap[i]);
+		highest = glm::max(highest, heightMap[i]);
+	}
+
+	//all air above the highest column, all solid below the lowest one
+	return highest >= chunkMinY && lowest < chunkMaxY;
 }
 
 //returns false if empty
-bool Density::GenerateMaterialIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, vector<int> &materialIndices, vector <float> &heightMap)
+bool Density::GenerateMaterialIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, OccupancyGrid &occupancy, vector <float> &heightMap)
 {
-	materialIndices.resize((chunkSize.x + 1) *  (chunkSize.y + 1) * (chunkSize.z + 1), -1);
 	glm::vec3 gridSize = chunkSize + glm::vec3(1.0f);
+	occupancy.Resize(glm::ivec3(gridSize));
 
-	bool activeChunk = false;
-	int material;
+	const int sampleCount = gridSize.x * gridSize.y * gridSize.z;
+	int solidCount = 0;
 
 	for (int x = 0; x <= chunkSize.x; x++)
 	{
@@ -380,24 +703,19 @@ bool Density::GenerateMaterialIndices(const glm::vec3 &chunkPos, const glm::vec3
 			int index = GETINDEXCHUNKXZ(gridSize, x, z);
 			float height = heightMap[index];
 
-			//set material indices
-			//probably bad cache performance
+			//set material for voxels
 			for (int y = 0; y <= chunkSize.y; y++)
 			{
-				float worldHeight = chunkPos.y + y * voxelSize;
-
-				////set material for voxels
-				int chunkIndex = GETINDEXCHUNK(gridSize, x, y, z);
-				materialIndices[chunkIndex] = worldHeight <= height ? MATERIAL_SOLID : MATERIAL_AIR;
-				
-				//check if chunk has a sign change
-				if (chunkIndex == 0)
-					material = materialIndices[chunkIndex];
-				else if (material != materialIndices[chunkIndex])
-					activeChunk = true;
+				float worldHeight = chunkPos.y + y * cellSize;
+				if (worldHeight <= height)
+				{
+					occupancy.SetSolid(x, y, z);
+					solidCount++;
+				}
 			}
 		}
 	}
 
-	return activeChunk;
-}
\ No newline at end of file
+	//chunk has a sign change if it is neither all air nor all solid
+	return solidCount > 0 && solidCount < sampleCount;
+}
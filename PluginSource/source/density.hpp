@@ -9,6 +9,9 @@ class Density
 	static float invVoxelSize;
 	static float maxHeight;
 	static float noiseScale;
+	static int chunkSize;
+
+	static HeightMapCache heightMapCache;
 
 	static FastNoise terrainFN;
 
@@ -25,11 +28,18 @@ public:
 
 	static void SetMaxVoxelHeight(const float & height);
 
+	static void SetChunkSize(const int & chunkSize);
+
+	//least recently used tiles are dropped when the cache shrinks
+	static void SetHeightMapCacheCapacity(size_t tiles);
+
 	static void Initialize();
 
 	static glm::vec3 FindIntersection(Density::DensityType type, const glm::vec3 &p0, const glm::vec3 &p1);
+	static void FindIntersections(Density::DensityType type, const vector<glm::vec3> &p0, const vector<glm::vec3> &p1, vector<glm::vec3> &intersections);
 	static glm::vec3 FindIntersection2D(Density::DensityType type, const glm::vec3 & p0, const glm::vec3 & p1);
 	static glm::vec3 CalculateNormals(Density::DensityType type, const glm::vec3 &pos);
+	static void CalculateNormals(Density::DensityType type, const vector<glm::vec3> &positions, vector<glm::vec3> &normals);
 
 	static glm::vec3 CalculateNormals2D(Density::DensityType type, const glm::vec3 & pos);
 
@@ -39,16 +49,22 @@ public:
 	
 	static float GetDensity(DensityType type, const glm::vec3 &worldPosition);
 	static float GetNoise2D(DensityType type, const glm::vec3 &worldPosition);
+	static float GetHeight2D(DensityType type, const glm::vec3 &worldPosition);
 	static float *GetDensitySet(DensityType type, const vector<glm::vec3> &positionSet);
+	static void FillDensitySet(DensityType type, float *set, FastNoiseVectorSet &positionSet);
 
 	static void FreeSet(float * set);
 
-	static void GenerateTerrainIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, vector<int> &materialIndices);
-	static void GenerateCaveIndices(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, vector<int>& materialIndices);
-	static void GenerateMaterialIndices(DensityType type, const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, vector<int>& materialIndices);
+	//chunkSize is in cells and cellSize is the world size of one cell, a multiple of the voxel size for lod chunks
+	static void GenerateTerrainIndices(const glm::vec3 &chunkPos, const glm::vec3 &chunkSize, float cellSize, OccupancyGrid &occupancy);
+	static void GenerateCaveIndices(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, float cellSize, OccupancyGrid &occupancy);
+	static void GenerateMaterialIndices(DensityType type, const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, float cellSize, OccupancyGrid &occupancy);
 
-	static void GenerateHeightMap(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, vector<float>& heightmap);
-	static bool GenerateMaterialIndices(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, vector<int>& materialIndices, vector<float> &heightMap);
+	static void GenerateHeightMap(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, float cellSize, vector<float>& heightmap);
+	static HeightMapCache::Tile GetHeightMapTile(const glm::ivec2 &tileIndex);
+	static bool GetCachedHeight(const glm::vec3 &worldPosition, float &height);
+	static bool TerrainChunkHasSurface(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, float cellSize, vector<float> &heightMap);
+	static bool GenerateMaterialIndices(const glm::vec3 & chunkPos, const glm::vec3 & chunkSize, float cellSize, OccupancyGrid &occupancy, vector<float> &heightMap);
 	static float GetCaveNoise(glm::vec3 worldPosition);
 
 };
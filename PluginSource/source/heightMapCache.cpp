@@ -0,0 +1,67 @@
+#include "VoxelPlugin.hpp"
+
+HeightMapCache::HeightMapCache(size_t capacity) : m_capacity(capacity)
+{
+
+}
+
+void HeightMapCache::SetCapacity(size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_capacity = capacity;
+
+	while (m_tiles.size() > m_capacity)
+	{
+		m_tiles.erase(m_lru.back());
+		m_lru.pop_back();
+	}
+}
+
+HeightMapCache::Tile HeightMapCache::Find(const glm::ivec2 &tileIndex)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	auto iter = m_tiles.find(tileIndex);
+	if (iter == m_tiles.end())
+		return nullptr;
+
+	//move to the front of the lru list
+	m_lru.splice(m_lru.begin(), m_lru, iter->second.lruPos);
+	return iter->second.tile;
+}
+
+HeightMapCache::Tile HeightMapCache::Insert(const glm::ivec2 &tileIndex, const Tile &tile)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	auto iter = m_tiles.find(tileIndex);
+	if (iter != m_tiles.end())
+	{
+		m_lru.splice(m_lru.begin(), m_lru, iter->second.lruPos);
+		return iter->second.tile;
+	}
+
+	if (m_capacity == 0)
+		return tile;
+
+	//evict least recently used tiles
+	while (m_tiles.size() >= m_capacity)
+	{
+		m_tiles.erase(m_lru.back());
+		m_lru.pop_back();
+	}
+
+	m_lru.push_front(tileIndex);
+	Entry &entry = m_tiles[tileIndex];
+	entry.tile = tile;
+	entry.lruPos = m_lru.begin();
+
+	return tile;
+}
+
+void HeightMapCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_tiles.clear();
+	m_lru.clear();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#define HEIGHTMAP_CACHE_TILES 1024
+
+//Thread safe LRU cache of raw 2D heightmap tiles keyed by XZ chunk index.
+//Tiles are (tileSize + 1)^2 heights in world space, laid out with GETINDEXCHUNKXZ
+class HeightMapCache
+{
+public:
+	typedef std::shared_ptr<const vector<float>> Tile;
+
+private:
+	typedef std::list<glm::ivec2> LRUList;
+
+	struct Entry
+	{
+		Tile tile;
+		LRUList::iterator lruPos;
+	};
+
+	std::mutex m_lock;
+	size_t m_capacity;
+	LRUList m_lru;
+	unordered_map<glm::ivec2, Entry> m_tiles;
+
+public:
+	HeightMapCache(size_t capacity = HEIGHTMAP_CACHE_TILES);
+
+	void SetCapacity(size_t capacity);
+
+	Tile Find(const glm::ivec2 &tileIndex);
+
+	//returns the cached tile if another thread inserted it first
+	Tile Insert(const glm::ivec2 &tileIndex, const Tile &tile);
+
+	void Clear();
+};
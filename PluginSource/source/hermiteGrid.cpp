@@ -0,0 +1,198 @@
+#include "VoxelPlugin.hpp"
+
+static const glm::ivec3 AXIS_DIRECTION[3] =
+{
+	glm::ivec3(1, 0, 0),
+	glm::ivec3(0, 1, 0),
+	glm::ivec3(0, 0, 1)
+};
+
+static inline int16_t EncodeSnorm(float value)
+{
+	return (int16_t)glm::round(glm::clamp(value, -1.f, 1.f) * HERMITE_NORMAL_SCALE);
+}
+
+static void EncodeNormal(const glm::vec3 &normal, int16_t out[2])
+{
+	float length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+	if (length <= 0.f)
+	{
+		out[0] = out[1] = 0;
+		return;
+	}
+
+	//project onto the octahedron and fold the lower half over the diagonals
+	glm::vec3 n = normal / length;
+	glm::vec2 oct(n.x, n.y);
+	if (n.z < 0.f)
+	{
+		oct.x = (1.f - glm::abs(n.y)) * (n.x >= 0.f ? 1.f : -1.f);
+		oct.y = (1.f - glm::abs(n.x)) * (n.y >= 0.f ? 1.f : -1.f);
+	}
+
+	out[0] = EncodeSnorm(oct.x);
+	out[1] = EncodeSnorm(oct.y);
+}
+
+static glm::vec3 DecodeNormal(const int16_t in[2])
+{
+	glm::vec3 n(in[0] / HERMITE_NORMAL_SCALE, in[1] / HERMITE_NORMAL_SCALE, 0.f);
+	n.z = 1.f - glm::abs(n.x) - glm::abs(n.y);
+	if (n.z < 0.f)
+	{
+		float x = n.x;
+		n.x = (1.f - glm::abs(n.y)) * (x >= 0.f ? 1.f : -1.f);
+		n.y = (1.f - glm::abs(x)) * (n.y >= 0.f ? 1.f : -1.f);
+	}
+
+	float length = glm::length(n);
+	return length > 0.f ? n / length : n;
+}
+
+HermiteGrid::HermiteGrid() : m_position(0.f), m_voxelSize(1.f)
+{
+
+}
+
+void HermiteGrid::Build(const OccupancyGrid &materials, const glm::vec3 &position, float voxelSize)
+{
+	const glm::ivec3 &size = materials.GetSize();
+	const int rowWords = materials.GetRowWords();
+
+	m_position = position;
+	m_voxelSize = voxelSize;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_crossings[axis].Resize(size);
+		m_rowOffsets[axis].resize(size.x * size.y + 1);
+	}
+
+	int offsets[3] = { 0, 0, 0 };
+	for (int x = 0; x < size.x; x++)
+	{
+		for (int y = 0; y < size.y; y++)
+		{
+			const uint64_t *row = materials.GetRow(x, y);
+			const uint64_t *rowX = x + 1 < size.x ? materials.GetRow(x + 1, y) : nullptr;
+			const uint64_t *rowY = y + 1 < size.y ? materials.GetRow(x, y + 1) : nullptr;
+
+			for (int axis = 0; axis < 3; axis++)
+				m_rowOffsets[axis][x * size.y + y] = offsets[axis];
+
+			for (int w = 0; w < rowWords; w++)
+			{
+				uint64_t crossings[3];
+				crossings[0] = rowX ? (row[w] ^ rowX[w]) & RangeMask(w, size.z) : 0;
+				crossings[1] = rowY ? (row[w] ^ rowY[w]) & RangeMask(w, size.z) : 0;
+				crossings[2] = (row[w] ^ ShiftNext(row, w, rowWords)) & RangeMask(w, size.z - 1);
+
+				for (int axis = 0; axis < 3; axis++)
+				{
+					m_crossings[axis].GetRow(x, y)[w] = crossings[axis];
+					offsets[axis] += PopCount(crossings[axis]);
+				}
+			}
+		}
+	}
+
+	HermiteEdge empty;
+	empty.t = HERMITE_EMPTY;
+	empty.normal[0] = empty.normal[1] = 0;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_rowOffsets[axis][size.x * size.y] = offsets[axis];
+		m_edges[axis].assign(offsets[axis], empty);
+	}
+}
+
+void HermiteGrid::Reset()
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_crossings[axis].Reset();
+		m_rowOffsets[axis].clear();
+		m_edges[axis].clear();
+	}
+}
+
+void HermiteGrid::Swap(HermiteGrid &other)
+{
+	std::swap(m_position, other.m_position);
+	std::swap(m_voxelSize, other.m_voxelSize);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_crossings[axis].Swap(other.m_crossings[axis]);
+		m_rowOffsets[axis].swap(other.m_rowOffsets[axis]);
+		m_edges[axis].swap(other.m_edges[axis]);
+	}
+}
+
+glm::ivec3 HermiteGrid::GetLocalPosition(const glm::vec3 &worldPos) const
+{
+	return glm::ivec3(glm::round((worldPos - m_position) / m_voxelSize));
+}
+
+int HermiteGrid::FindSlot(const glm::ivec3 &edge, int axis) const
+{
+	const OccupancyGrid &crossings = m_crossings[axis];
+	const glm::ivec3 &size = crossings.GetSize();
+	if (edge.x < 0 || edge.y < 0 || edge.z < 0 || edge.x >= size.x || edge.y >= size.y || edge.z >= size.z)
+		return -1;
+
+	if (!crossings.GetMaterial(edge.x, edge.y, edge.z))
+		return -1;
+
+	//rank of the edge within its row
+	const uint64_t *row = crossings.GetRow(edge.x, edge.y);
+	const int word = edge.z >> 6;
+	int slot = m_rowOffsets[axis][edge.x * size.y + edge.y];
+	for (int w = 0; w < word; w++)
+		slot += PopCount(row[w]);
+	slot += PopCount(row[word] & RangeMask(0, edge.z & 63));
+
+	return slot;
+}
+
+void HermiteGrid::SetEdge(const glm::ivec3 &edge, int axis, const glm::vec3 &crossing, const glm::vec3 &normal)
+{
+	int slot = FindSlot(edge, axis);
+	if (slot < 0)
+		return;
+
+	glm::vec3 start = m_position + glm::vec3(edge) * m_voxelSize;
+	float t = glm::clamp((crossing[axis] - start[axis]) / m_voxelSize, 0.f, 1.f);
+
+	HermiteEdge &data = m_edges[axis][slot];
+	data.t = (uint16_t)glm::round(t * HERMITE_T_SCALE);
+	EncodeNormal(normal, data.normal);
+}
+
+bool HermiteGrid::GetEdge(const glm::ivec3 &edge, int axis, glm::vec3 &crossing, glm::vec3 &normal) const
+{
+	int slot = FindSlot(edge, axis);
+	if (slot < 0)
+		return false;
+
+	const HermiteEdge &data = m_edges[axis][slot];
+	if (data.t == HERMITE_EMPTY)
+		return false;
+
+	float t = data.t / HERMITE_T_SCALE;
+	crossing = m_position + (glm::vec3(edge) + glm::vec3(AXIS_DIRECTION[axis]) * t) * m_voxelSize;
+	normal = DecodeNormal(data.normal);
+
+	return true;
+}
+
+size_t HermiteGrid::GetMemoryUsage() const
+{
+	size_t total = 0;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		total += m_crossings[axis].GetMemoryUsage();
+		total += m_rowOffsets[axis].capacity() * sizeof(int);
+		total += m_edges[axis].capacity() * sizeof(HermiteEdge);
+	}
+	return total;
+}
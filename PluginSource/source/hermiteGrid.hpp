@@ -0,0 +1,49 @@
+#pragma once
+
+#define HERMITE_EMPTY 0xFFFF
+#define HERMITE_T_SCALE 65534.f
+#define HERMITE_NORMAL_SCALE 32767.f
+
+//Compact hermite sample, 6 bytes. t is the crossing along the edge in [0, 1],
+//the normal is octahedral encoded into two snorm16 values
+struct HermiteEdge
+{
+	uint16_t t;
+	int16_t normal[2];
+};
+
+//Per chunk hermite data stored per axis and addressed by integer (x, y, z, axis).
+//Only edges with a material change get a slot, a slot is found by testing the
+//edge's crossing bit and ranking it within its row like NodeGrid does for cells
+class HermiteGrid
+{
+	glm::vec3 m_position;
+	float m_voxelSize;
+	OccupancyGrid m_crossings[3];
+	vector<int> m_rowOffsets[3];
+	vector<HermiteEdge> m_edges[3];
+
+	int FindSlot(const glm::ivec3 &edge, int axis) const;
+
+public:
+	HermiteGrid();
+
+	//marks every edge of the material grid that has a sign change, all slots start empty
+	void Build(const OccupancyGrid &materials, const glm::vec3 &position, float voxelSize);
+
+	//empties the grid, its storage is kept for the next Build
+	void Reset();
+
+	void Swap(HermiteGrid &other);
+
+	//local integer position of a world space point on the sample grid
+	glm::ivec3 GetLocalPosition(const glm::vec3 &worldPos) const;
+
+	//stores the world space crossing and normal of an edge, ignored if the edge has no sign change
+	void SetEdge(const glm::ivec3 &edge, int axis, const glm::vec3 &crossing, const glm::vec3 &normal);
+
+	//decodes the world space crossing and normal, returns false if the edge has no data
+	bool GetEdge(const glm::ivec3 &edge, int axis, glm::vec3 &crossing, glm::vec3 &normal) const;
+
+	size_t GetMemoryUsage() const;
+};
@@ -0,0 +1,829 @@
+#include "VoxelPlugin.hpp"
+#include "enkiTS\TaskScheduler.h"
+#include <set>
+#include <algorithm>
+
+#define TRAVERSE_CELL 0
+#define TRAVERSE_FACE 1
+#define TRAVERSE_EDGE 2
+
+//spreads the low 21 bits of v so every bit is followed by two zero bits
+static inline uint64_t SpreadBits(uint64_t v)
+{
+	v &= 0x1fffff;
+	v = (v | v << 32) & 0x1f00000000ffff;
+	v = (v | v << 16) & 0x1f0000ff0000ff;
+	v = (v | v << 8) & 0x100f00f00f00f00f;
+	v = (v | v << 4) & 0x10c30c30c30c30c3;
+	v = (v | v << 2) & 0x1249249249249249;
+	return v;
+}
+
+//interleaved x, y, z bits, the low 3 bits of a code match GETINDEXXYZ
+static inline uint64_t MortonCode(const glm::ivec3 &cell)
+{
+	return (SpreadBits(cell.x) << 2) | (SpreadBits(cell.y) << 1) | SpreadBits(cell.z);
+}
+
+//node of one level while the tree is built bottom up
+struct BuildNode
+{
+	uint64_t code;
+	glm::ivec3 position;
+	uint32_t first; //first child in the level below, or the leaf index for leaves
+	uint8_t childMask;
+};
+
+static bool MortonLess(const BuildNode &a, const BuildNode &b)
+{
+	return a.code < b.code;
+}
+
+static bool MortonEqual(const BuildNode &a, const BuildNode &b)
+{
+	return a.code == b.code;
+}
+
+static inline TraversalTask MakeTask(int type, int direction, uint32_t a, uint32_t b, uint32_t c = LINEAR_OCTREE_NULL, uint32_t d = LINEAR_OCTREE_NULL)
+{
+	TraversalTask task;
+	task.type = type;
+	task.direction = direction;
+	task.nodes[0] = a;
+	task.nodes[1] = b;
+	task.nodes[2] = c;
+	task.nodes[3] = d;
+	return task;
+}
+
+LinearOctree::LinearOctree() : m_position(0.f), m_leafSize(1), m_seamRegion(0), m_seamBoundary(0)
+{
+
+}
+
+void LinearOctree::Build(const vector<Octree*> &leaves, const glm::vec3 &origin)
+{
+	Clear();
+	if (leaves.size() < 1) return;
+
+	m_position = origin;
+	m_leafSize = leaves[0]->m_size;
+	for (const Octree *leaf : leaves)
+		m_leafSize = std::min(m_leafSize, leaf->m_size);
+	const glm::ivec3 floorOrigin = origin;
+
+	//seams between lod rings mix leaf sizes, a leaf enters the tree at the level matching its size
+	vector<vector<BuildNode>> leafLevels(1);
+	for (size_t i = 0; i < leaves.size(); i++)
+	{
+		int level = 0;
+		while ((m_leafSize << level) < leaves[i]->m_size)
+			level++;
+		if (level >= (int)leafLevels.size())
+			leafLevels.resize(level + 1);
+
+		BuildNode node;
+		node.position = (glm::ivec3(leaves[i]->m_minPos) - floorOrigin) / m_leafSize;
+		node.code = MortonCode(node.position >> level);
+		node.first = i;
+		node.childMask = 0;
+		leafLevels[level].push_back(node);
+	}
+
+	//sort once by morton code, siblings are then adjacent at every level.
+	//seam gathers can return a cell twice where neighbour ranges overlap
+	for (vector<BuildNode> &leafLevel : leafLevels)
+	{
+		std::sort(leafLevel.begin(), leafLevel.end(), MortonLess);
+		leafLevel.erase(std::unique(leafLevel.begin(), leafLevel.end(), MortonEqual), leafLevel.end());
+	}
+
+	vector<vector<BuildNode>> levels(1);
+	levels[0].swap(leafLevels[0]);
+
+	//group consecutive nodes sharing a parent code until one node is left,
+	//larger leaves are merged in once their level is reached
+	while (levels.back().size() > 1 || levels.size() < leafLevels.size())
+	{
+		const int level = levels.size();
+		levels.push_back(vector<BuildNode>());
+		const vector<BuildNode> &children = levels[level - 1];
+		vector<BuildNode> &parents = levels[level];
+
+		for (size_t i = 0; i < children.size();)
+		{
+			BuildNode parent;
+			parent.code = children[i].code >> 3;
+			parent.position = (children[i].position >> level) << level;
+			parent.first = i;
+			parent.childMask = 0;
+
+			for (; i < children.size() && (children[i].code >> 3) == parent.code; i++)
+				parent.childMask |= 1 << (children[i].code & 7);
+
+			parents.push_back(parent);
+		}
+
+		if (level < (int)leafLevels.size() && !leafLevels[level].empty())
+		{
+			const int parentCount = parents.size();
+			parents.insert(parents.end(), leafLevels[level].begin(), leafLevels[level].end());
+			std::inplace_merge(parents.begin(), parents.begin() + parentCount, parents.end(), MortonLess);
+			parents.erase(std::unique(parents.begin(), parents.end(), MortonEqual), parents.end());
+		}
+	}
+
+	//lay the levels out root first
+	const int depth = levels.size() - 1;
+	vector<uint32_t> levelStart(levels.size());
+	uint32_t nodeCount = 0;
+	for (int level = depth; level >= 0; level--)
+	{
+		levelStart[level] = nodeCount;
+		nodeCount += levels[level].size();
+	}
+
+	m_nodes.resize(nodeCount);
+	m_vertices.assign(nodeCount, nullptr);
+
+	for (int level = depth; level >= 0; level--)
+	{
+		for (size_t i = 0; i < levels[level].size(); i++)
+		{
+			const BuildNode &source = levels[level][i];
+			const uint32_t index = levelStart[level] + i;
+			LinearOctreeNode &node = m_nodes[index];
+
+			node.position[0] = source.position.x;
+			node.position[1] = source.position.y;
+			node.position[2] = source.position.z;
+			node.level = level;
+			node.childIndex = source.code & 7;
+			node.childMask = source.childMask;
+
+			if (source.childMask)
+			{
+				node.firstChild = levelStart[level - 1] + source.first;
+				node.corners = 0;
+				node.vertexCount = 0;
+			}
+			else
+			{
+				const Octree *leaf = leaves[source.first];
+				node.firstChild = LINEAR_OCTREE_NULL;
+				node.corners = leaf->m_corners;
+				node.vertexCount = leaf->m_vertex_count;
+				m_vertices[index] = leaf->m_vertices;
+			}
+		}
+	}
+}
+
+void LinearOctree::Clear()
+{
+	m_nodes.clear();
+	m_vertices.clear();
+	m_seamRegion = 0;
+	m_seamVertexBase.clear();
+}
+
+void LinearOctree::SetSeamRegion(int region, const glm::vec3 &chunkSize)
+{
+	m_seamRegion = region;
+	m_seamBoundary = glm::ivec3(chunkSize) / m_leafSize;
+}
+
+int LinearOctree::GetEdgeRegion(const uint32_t nodes[4]) const
+{
+	int shared = 7;
+	int region = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		const int side = GetSeamSide(nodes[i]);
+		shared &= side;
+		region |= side;
+	}
+
+	//the chunk holding the lowest cell of an edge owns it
+	return shared ? 0 : region;
+}
+
+//highest clustered ancestor that may stand in for a leaf vertex at this error,
+//a negative threshold never reads the simplification data
+static VoxelVertex *ResolveVertex(VoxelVertex *v, float threshold)
+{
+	if (threshold < 0.f)
+		return v;
+
+	VoxelVertex *resolved = v;
+	for (VoxelVertex *parent = v->GetParent(); parent; parent = parent->GetParent())
+	{
+		VoxelVertexData *data = parent->data;
+		if (data->IsCollapsible() && data->error <= threshold && data->IsManifold())
+			resolved = parent;
+	}
+	return resolved;
+}
+
+void LinearOctree::GenerateVertexBuffer(vector<Vertex> &vertices, float threshold)
+{
+	if (m_nodes.empty()) return;
+
+	//mark the vertices the leaves resolve to, the rest are left out of the buffer
+	for (uint32_t node = 0; node < m_nodes.size(); node++)
+	{
+		if (!m_vertices[node]) continue;
+		for (int i = 0; i < m_nodes[node].vertexCount; i++)
+			m_vertices[node][i].index = ~0u;
+	}
+	for (uint32_t node = 0; node < m_nodes.size(); node++)
+	{
+		if (!IsLeaf(node)) continue;
+		for (int i = 0; i < m_nodes[node].vertexCount; i++)
+			ResolveVertex(&m_vertices[node][i], threshold)->index = 0;
+	}
+
+	//post order, children before their parent
+	vector<std::pair<uint32_t, bool>> stack;
+	stack.push_back(std::make_pair(0u, false));
+	while (!stack.empty())
+	{
+		const uint32_t node = stack.back().first;
+		const bool expanded = stack.back().second;
+		stack.pop_back();
+
+		if (!expanded && !IsLeaf(node))
+		{
+			stack.push_back(std::make_pair(node, true));
+			for (int i = 7; i >= 0; i--)
+			{
+				uint32_t child = GetChild(node, i);
+				if (child != LINEAR_OCTREE_NULL)
+					stack.push_back(std::make_pair(child, false));
+			}
+			continue;
+		}
+
+		VoxelVertex *nodeVertices = m_vertices[node];
+		if (!nodeVertices) continue;
+
+		for (int i = 0; i < m_nodes[node].vertexCount; i++)
+		{
+			if (nodeVertices[i].index == ~0u) continue;
+
+			nodeVertices[i].index = vertices.size();
+			Vertex v;
+			v.pos = nodeVertices[i].position;
+			v.normal = nodeVertices[i].normal;
+			vertices.push_back(v);
+		}
+	}
+}
+
+void LinearOctree::GenerateSeamVertexBuffer(vector<Vertex> &vertices, GLuint firstIndex)
+{
+	//leaf indices are never written here, neighbouring seams share the leaves
+	m_seamVertexBase.assign(m_nodes.size(), LINEAR_OCTREE_NULL);
+	for (uint32_t node = 0; node < m_nodes.size(); node++)
+	{
+		if (!IsLeaf(node) || GetSeamSide(node) == 0)
+			continue;
+
+		m_seamVertexBase[node] = firstIndex + vertices.size();
+		for (int i = 0; i < m_nodes[node].vertexCount; i++)
+		{
+			Vertex v;
+			v.pos = m_vertices[node][i].position;
+			v.normal = m_vertices[node][i].normal;
+			vertices.push_back(v);
+		}
+	}
+}
+
+void LinearOctree::PushCellTasks(uint32_t node, vector<TraversalTask> &stack) const
+{
+	for (int i = 5; i >= 0; i--)
+	{
+		stack.push_back(MakeTask(TRAVERSE_EDGE, cell_proc_edge_mask[i][4],
+			GetChild(node, cell_proc_edge_mask[i][0]), GetChild(node, cell_proc_edge_mask[i][1]),
+			GetChild(node, cell_proc_edge_mask[i][2]), GetChild(node, cell_proc_edge_mask[i][3])));
+	}
+
+	for (int i = 11; i >= 0; i--)
+	{
+		stack.push_back(MakeTask(TRAVERSE_FACE, edge_pairs[i][2],
+			GetChild(node, edge_pairs[i][0]), GetChild(node, edge_pairs[i][1])));
+	}
+}
+
+void LinearOctree::PushFaceTasks(const TraversalTask &task, bool subdivideFace, vector<TraversalTask> &stack) const
+{
+	const int orders[2][4] =
+	{
+		{ 0, 0, 1, 1 },
+		{ 0, 1, 0, 1 },
+	};
+
+	const int direction = task.direction;
+	for (int i = 3; i >= 0; i--)
+	{
+		const int *mask = face_proc_edge_mask[direction][i];
+		const int *order = orders[mask[0]];
+		stack.push_back(MakeTask(TRAVERSE_EDGE, mask[5],
+			GetChildOrLeaf(task.nodes[order[0]], mask[1]), GetChildOrLeaf(task.nodes[order[1]], mask[2]),
+			GetChildOrLeaf(task.nodes[order[2]], mask[3]), GetChildOrLeaf(task.nodes[order[3]], mask[4])));
+	}
+
+	if (!subdivideFace)
+		return;
+
+	for (int i = 3; i >= 0; i--)
+	{
+		const int *mask = face_proc_face_mask[direction][i];
+		stack.push_back(MakeTask(TRAVERSE_FACE, mask[2],
+			GetChildOrLeaf(task.nodes[0], mask[0]), GetChildOrLeaf(task.nodes[1], mask[1])));
+	}
+}
+
+void LinearOctree::PushEdgeTasks(const TraversalTask &task, vector<TraversalTask> &stack) const
+{
+	for (int i = 1; i >= 0; i--)
+	{
+		const int *mask = edge_proc_edge_mask[task.direction][i];
+		stack.push_back(MakeTask(TRAVERSE_EDGE, mask[4],
+			GetChildOrLeaf(task.nodes[0], mask[0]), GetChildOrLeaf(task.nodes[1], mask[1]),
+			GetChildOrLeaf(task.nodes[2], mask[2]), GetChildOrLeaf(task.nodes[3], mask[3])));
+	}
+}
+
+void LinearOctree::ExpandTask(const TraversalTask &task, vector<TraversalTask> &stack, vector<GLuint> &indexes, float threshold) const
+{
+	const uint32_t *nodes = task.nodes;
+	switch (task.type)
+	{
+	case TRAVERSE_CELL:
+		if (IsLeaf(nodes[0]))
+			break;
+
+		PushCellTasks(nodes[0], stack);
+		for (int i = 7; i >= 0; i--)
+		{
+			uint32_t child = GetChild(nodes[0], i);
+			if (child != LINEAR_OCTREE_NULL)
+				stack.push_back(MakeTask(TRAVERSE_CELL, 0, child, LINEAR_OCTREE_NULL));
+		}
+		break;
+
+	case TRAVERSE_FACE:
+		if (nodes[0] == LINEAR_OCTREE_NULL || nodes[1] == LINEAR_OCTREE_NULL)
+			break;
+
+		if (!IsLeaf(nodes[0]) || !IsLeaf(nodes[1]))
+			PushFaceTasks(task, true, stack);
+		break;
+
+	case TRAVERSE_EDGE:
+		if (nodes[0] == LINEAR_OCTREE_NULL || nodes[1] == LINEAR_OCTREE_NULL || nodes[2] == LINEAR_OCTREE_NULL || nodes[3] == LINEAR_OCTREE_NULL)
+			break;
+
+		if (IsLeaf(nodes[0]) && IsLeaf(nodes[1]) && IsLeaf(nodes[2]) && IsLeaf(nodes[3]))
+		{
+			if (m_seamRegion == 0 || GetEdgeRegion(nodes) == m_seamRegion)
+				ProcessIndexes(nodes, task.direction, indexes, threshold);
+		}
+		else
+			PushEdgeTasks(task, stack);
+		break;
+	}
+}
+
+int LinearOctree::GetTaskLevel(const TraversalTask &task) const
+{
+	int level = 0;
+	for (int i = 0; i < 4; i++)
+		if (task.nodes[i] != LINEAR_OCTREE_NULL)
+			level = std::max(level, (int)m_nodes[task.nodes[i]].level);
+	return level;
+}
+
+void LinearOctree::ProcessTask(const TraversalTask &root, vector<GLuint> &indexes, float threshold) const
+{
+	vector<TraversalTask> stack;
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const TraversalTask task = stack.back();
+		stack.pop_back();
+		ExpandTask(task, stack, indexes, threshold);
+	}
+}
+
+void LinearOctree::SplitTasks(int splitLevel, vector<TraversalTask> &tasks) const
+{
+	//indexes are only emitted by leaf edges, which always fall below the split
+	vector<GLuint> unused;
+	vector<TraversalTask> stack;
+	stack.push_back(MakeTask(TRAVERSE_CELL, 0, 0, LINEAR_OCTREE_NULL));
+	while (!stack.empty())
+	{
+		const TraversalTask task = stack.back();
+		stack.pop_back();
+
+		if (GetTaskLevel(task) <= splitLevel)
+			tasks.push_back(task);
+		else
+			ExpandTask(task, stack, unused, 0.f);
+	}
+}
+
+//contours a range of the split tasks, each into its own index buffer
+struct ProcessCellTaskSet : enki::ITaskSet
+{
+	const LinearOctree *octree;
+	const vector<TraversalTask> *tasks;
+	vector<vector<GLuint>> *indexes;
+	float threshold;
+
+	ProcessCellTaskSet(const LinearOctree *octree, const vector<TraversalTask> *tasks, vector<vector<GLuint>> *indexes, float threshold)
+	{
+		m_SetSize = tasks->size();
+		this->octree = octree;
+		this->tasks = tasks;
+		this->indexes = indexes;
+		this->threshold = threshold;
+	}
+
+	void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum)
+	{
+		for (uint32_t i = range.start; i < range.end; i++)
+			octree->ProcessTask((*tasks)[i], (*indexes)[i], threshold);
+	}
+};
+
+void LinearOctree::ProcessCell(vector<GLuint> &indexes, float threshold, enki::TaskScheduler *scheduler) const
+{
+	if (m_nodes.empty()) return;
+
+	const int rootLevel = m_nodes[0].level;
+	if (!scheduler || m_nodes.size() < LINEAR_OCTREE_PARALLEL_NODES || rootLevel <= LINEAR_OCTREE_SPLIT_DEPTH)
+	{
+		ProcessTask(MakeTask(TRAVERSE_CELL, 0, 0, LINEAR_OCTREE_NULL), indexes, threshold);
+		return;
+	}
+
+	//the split tasks come out in the order the serial traversal would reach them,
+	//so appending their buffers in order reproduces its triangle order
+	vector<TraversalTask> tasks;
+	SplitTasks(rootLevel - LINEAR_OCTREE_SPLIT_DEPTH, tasks);
+
+	vector<vector<GLuint>> taskIndexes(tasks.size());
+	ProcessCellTaskSet taskSet(this, &tasks, &taskIndexes, threshold);
+	scheduler->AddTaskSetToPipe(&taskSet);
+	scheduler->WaitforTaskSet(&taskSet);
+
+	size_t total = indexes.size();
+	for (const vector<GLuint> &taskIndex : taskIndexes)
+		total += taskIndex.size();
+	indexes.reserve(total);
+	for (const vector<GLuint> &taskIndex : taskIndexes)
+		indexes.insert(indexes.end(), taskIndex.begin(), taskIndex.end());
+}
+
+void LinearOctree::ProcessIndexes(const uint32_t nodes[4], int direction, vector<GLuint> &indexes, float threshold) const
+{
+	unsigned int min_level = 0xFF;
+	unsigned int indices[4] = { ~0u, ~0u, ~0u, ~0u };
+	bool flip = false;
+	bool sign_changed = false;
+
+	for (int i = 0; i < 4; i++)
+	{
+		const LinearOctreeNode &node = m_nodes[nodes[i]];
+		int edge = process_edge_mask[direction][i];
+		int c1 = edge_pairs[edge][0];
+		int c2 = edge_pairs[edge][1];
+
+		int m1 = (node.corners >> c1) & 1;
+		int m2 = (node.corners >> c2) & 1;
+
+		if (node.level < min_level)
+		{
+			min_level = node.level;
+			flip = m2 == 1;
+			sign_changed = ((!m1 && m2) || (m1 && !m2));
+		}
+
+		int index = edge_vertex_table[node.corners][edge];
+		if (index < 0)
+			continue;
+		if (index >= node.vertexCount)
+			return;
+
+		const uint32_t seamBase = m_seamVertexBase.empty() ? LINEAR_OCTREE_NULL : m_seamVertexBase[nodes[i]];
+		if (seamBase != LINEAR_OCTREE_NULL)
+			indices[i] = seamBase + index;
+		else
+			indices[i] = ResolveVertex(&m_vertices[nodes[i]][index], threshold)->index;
+	}
+
+	if (sign_changed)
+	{
+		if (flip)
+		{
+			//later flip the normal too
+			if (indices[0] != ~0u && indices[1] != ~0u && indices[3] != ~0u && indices[0] != indices[1] && indices[1] != indices[3])
+			{
+				indexes.push_back(indices[0]);
+				indexes.push_back(indices[1]);
+				indexes.push_back(indices[3]);
+			}
+
+			if (indices[0] != ~0u && indices[2] != ~0u && indices[3] != ~0u && indices[0] != indices[2] && indices[2] != indices[3])
+			{
+				indexes.push_back(indices[0]);
+				indexes.push_back(indices[3]);
+				indexes.push_back(indices[2]);
+			}
+		}
+		else
+		{
+			if (indices[0] != ~0u && indices[3] != ~0u && indices[1] != ~0u && indices[0] != indices[1] && indices[1] != indices[3])
+			{
+				indexes.push_back(indices[0]);
+				indexes.push_back(indices[3]);
+				indexes.push_back(indices[1]);
+			}
+
+			if (indices[0] != ~0u && indices[2] != ~0u && indices[3] != ~0u && indices[0] != indices[2] && indices[2] != indices[3])
+			{
+				indexes.push_back(indices[0]);
+				indexes.push_back(indices[2]);
+				indexes.push_back(indices[3]);
+			}
+		}
+	}
+}
+
+void LinearOctree::ClusterCellBase(float error, const glm::ivec3 &size, MemoryArena &arena, MemoryArena &dataArena)
+{
+	//deeper levels are stored later, walking backwards visits children before parents.
+	//the root itself is left unclustered
+	for (int i = (int)m_nodes.size() - 1; i > 0; i--)
+	{
+		if (IsLeaf(i))
+			continue;
+
+		//seams stitch to the leaves on the boundary, so cells touching it never collapse
+		const LinearOctreeNode &n = m_nodes[i];
+		const int span = 1 << n.level;
+		bool boundary = false;
+		for (int axis = 0; axis < 3; axis++)
+			boundary |= n.position[axis] == 0 || n.position[axis] + span >= size[axis];
+
+		ClusterCell(i, boundary ? -1.f : error, arena, dataArena);
+	}
+}
+
+void LinearOctree::ClusterCell(uint32_t node, float error, MemoryArena &arena, MemoryArena &dataArena)
+{
+	int surface_index = 0;
+	std::vector<VoxelVertex*> collected_vertices;
+
+	/*
+	* Find all the surfaces inside the children that cross the 6 Euclidean edges and the vertices that connect to them
+	*/
+	vector<TraversalTask> stack;
+	PushCellTasks(node, stack);
+	while (!stack.empty())
+	{
+		const TraversalTask task = stack.back();
+		stack.pop_back();
+
+		const uint32_t *nodes = task.nodes;
+		if (task.type == TRAVERSE_FACE)
+		{
+			if (nodes[0] == LINEAR_OCTREE_NULL || nodes[1] == LINEAR_OCTREE_NULL)
+				continue;
+
+			PushFaceTasks(task, !IsLeaf(nodes[0]) || !IsLeaf(nodes[1]), stack);
+		}
+		else
+		{
+			bool leaves = true;
+			for (int j = 0; j < 4; j++)
+				leaves &= nodes[j] == LINEAR_OCTREE_NULL || IsLeaf(nodes[j]);
+
+			if (leaves)
+				ClusterIndexes(nodes, task.direction, surface_index, collected_vertices);
+			else
+				PushEdgeTasks(task, stack);
+		}
+	}
+
+	int highest_index = surface_index;
+	if (highest_index == -1)
+		highest_index = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		uint32_t child = GetChild(node, i);
+		if (child == LINEAR_OCTREE_NULL)
+			continue;
+		for (int k = 0; k < m_nodes[child].vertexCount; k++)
+		{
+			VoxelVertex* v = &m_vertices[child][k];
+			if (v->data->surface_index == -1)
+			{
+				v->data->surface_index = highest_index++;
+				collected_vertices.push_back(v);
+			}
+		}
+	}
+
+	if (collected_vertices.size() == 0)
+		return;
+
+	std::set<int> surface_set;
+	for (auto& v : collected_vertices)
+	{
+		surface_set.insert(v->data->surface_index);
+	}
+	if (surface_set.size() == 0)
+		return;
+	assert(surface_set.size() <= UINT16_MAX);
+
+	//old vertices stay in the arena until the chunk is reset
+	VoxelVertex *nodeVertices = arena.NewArray<VoxelVertex>(surface_set.size());
+	VoxelVertexData *nodeData = dataArena.NewArray<VoxelVertexData>(surface_set.size());
+	int vertexCount = 0;
+	m_vertices[node] = nodeVertices;
+	m_nodes[node].vertexCount = surface_set.size();
+
+	for (int i = 0; i <= highest_index; i++)
+	{
+		QEFSolver qef;
+		glm::vec3 normal(0, 0, 0);
+		glm::vec3 positions(0, 0, 0);
+		int count = 0;
+		int edges[12] = { 0 };
+		int euler = 0;
+		int e = 0;
+
+		/* manifold criterion */
+		for (auto& v : collected_vertices)
+		{
+			const VoxelVertexData *data = v->data;
+			if (data->surface_index == i)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					int edge = external_edges[data->in_cell][k];
+					edges[edge] += data->eis[edge];
+				}
+				for (int k = 0; k < 9; k++)
+				{
+					int edge = internal_edges[data->in_cell][k];
+					e += data->eis[edge];
+				}
+
+				euler += data->euler;
+				qef.add(data->qef.getData());
+				normal += v->normal;
+				positions += v->position;
+				count++;
+			}
+		}
+
+		if (count == 0)
+			continue;
+
+		bool face_prop2 = true;
+		for (int f = 0; f < 6 && face_prop2; f++)
+		{
+			int intersections = 0;
+			for (int ei = 0; ei < 4; ei++)
+			{
+				intersections += edges[faces[f][ei]];
+			}
+			if (!(intersections == 0 || intersections == 2))
+				face_prop2 = false;
+		}
+
+		VoxelVertex &new_vertex = nodeVertices[vertexCount];
+		VoxelVertexData &data = nodeData[vertexCount];
+		new_vertex.data = &data;
+		positions /= (float)count;
+		normal /= (float)count;
+		normal = glm::normalize(normal);
+		new_vertex.normal = normal;
+		data.euler = euler - e / 4;
+		data.in_cell = m_nodes[node].childIndex;
+		memcpy(&data.qef, &qef, sizeof(qef));
+		memcpy(&data.eis, &edges, sizeof(edges));
+
+		//solved like the leaves so the vertex buffer never needs the qef
+		Vec3 p_out;
+
+		qef.solve(p_out, 1e-6, 4, 1e-6);
+		new_vertex.position = glm::vec3(p_out.x, p_out.y, p_out.z);
+		data.error = qef.getError();
+		if (data.error <= error)
+			data.flags |= VoxelVertexFlags::COLLAPSIBLE;
+		if (face_prop2)
+			data.flags |= VoxelVertexFlags::FACEPROP2;
+		data.flags |= 8;
+
+		for (auto& v : collected_vertices)
+		{
+			if (v->data->surface_index == i)
+				v->data->parent = &new_vertex;
+		}
+		vertexCount++;
+	}
+
+	for (auto& v : collected_vertices)
+	{
+		v->data->surface_index = -1;
+	}
+}
+
+void LinearOctree::ClusterIndexes(const uint32_t nodes[4], int direction, int &max_surface_index, vector<VoxelVertex*> &collected_vertices) const
+{
+	if (nodes[0] == LINEAR_OCTREE_NULL && nodes[1] == LINEAR_OCTREE_NULL && nodes[2] == LINEAR_OCTREE_NULL && nodes[3] == LINEAR_OCTREE_NULL)
+		return;
+
+	VoxelVertex* vertices[4] = { 0, 0, 0, 0 };
+	int v_count = 0;
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (nodes[i] == LINEAR_OCTREE_NULL)
+			continue;
+
+		const LinearOctreeNode &node = m_nodes[nodes[i]];
+		int corners = node.corners;
+		int edge = process_edge_mask[direction][i];
+		int c1 = edge_pairs[edge][0];
+		int c2 = edge_pairs[edge][1];
+
+		int m1 = (corners >> c1) & 1;
+		int m2 = (corners >> c2) & 1;
+
+		int index = edge_vertex_table[corners][edge];
+		bool skip = false;
+		if (index < 0)
+		{
+			//a crossing the table has no vertex for falls back to the last vertex
+			if (!((m1 == 0 && m2 != 0) || (m1 != 0 && m2 == 0)))
+				skip = true;
+			index = vertex_count_table[corners] - 1;
+		}
+
+		if (!skip && index < node.vertexCount)
+		{
+			vertices[i] = &m_vertices[nodes[i]][index];
+			while (vertices[i]->data->parent)
+				vertices[i] = vertices[i]->data->parent;
+			v_count++;
+		}
+	}
+
+	if (!v_count)
+		return;
+
+	int surface_index = -1;
+
+	for (int i = 0; i < 4; i++)
+	{
+		VoxelVertex* v = vertices[i];
+		if (!v)
+			continue;
+		if (v->data->surface_index != -1)
+		{
+			if (surface_index != -1 && surface_index != v->data->surface_index)
+			{
+				//merge the two surfaces
+				const int from = v->data->surface_index;
+				for (auto& c : collected_vertices)
+				{
+					if (c && c->data->surface_index == from)
+						c->data->surface_index = surface_index;
+				}
+			}
+			else if (surface_index == -1)
+				surface_index = v->data->surface_index;
+		}
+	}
+
+	if (surface_index == -1)
+		surface_index = max_surface_index++;
+	for (int i = 0; i < 4; i++)
+	{
+		VoxelVertex* v = vertices[i];
+		if (!v)
+			continue;
+		if (v->data->surface_index == -1)
+			collected_vertices.push_back(v);
+		v->data->surface_index = surface_index;
+	}
+}
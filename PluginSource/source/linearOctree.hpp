@@ -0,0 +1,121 @@
+#pragma once
+
+#define LINEAR_OCTREE_NULL 0xFFFFFFFF
+#define LINEAR_OCTREE_SPLIT_DEPTH 2        //levels below the root contoured serially before splitting into tasks
+#define LINEAR_OCTREE_PARALLEL_NODES 4096  //smaller trees are contoured on the calling thread
+
+namespace enki { class TaskScheduler; }
+
+//16 byte node, children of a node are stored contiguously in slot order
+struct LinearOctreeNode
+{
+	uint32_t firstChild;  //index of the first child, LINEAR_OCTREE_NULL for leaves
+	uint16_t position[3]; //min corner in leaf units from the tree origin
+	uint16_t vertexCount; //clustered inner nodes can hold more surfaces than a byte counts
+	uint8_t childMask;
+	uint8_t level;        //the node spans leafSize << level, larger leaves of a mixed size seam sit above 0
+	uint8_t corners;
+	uint8_t childIndex;   //slot in the parent
+};
+
+//pending cell, face or edge visit of a dual contouring traversal
+struct TraversalTask
+{
+	int type;
+	int direction;
+	uint32_t nodes[4];
+};
+
+//Pointerless octree over one chunk or seam. Nodes live in one array, root first
+//and then every level in morton order, so siblings and cousins sit next to
+//each other. Traversals use an explicit stack instead of recursion
+class LinearOctree
+{
+	vector<LinearOctreeNode> m_nodes;
+	vector<VoxelVertex*> m_vertices; //vertex array of each node, leaves point at their Octree's vertices
+	glm::vec3 m_position;
+	int m_leafSize;
+
+	int m_seamRegion;          //only edges of this seam region are contoured, 0 contours every edge
+	glm::ivec3 m_seamBoundary; //far corner of the owning chunk in leaf units
+	vector<GLuint> m_seamVertexBase; //first seam index of each neighbour leaf, LINEAR_OCTREE_NULL where the body index is used
+
+	inline bool IsLeaf(uint32_t node) const { return m_nodes[node].firstChild == LINEAR_OCTREE_NULL; }
+
+	inline uint32_t GetChild(uint32_t node, int slot) const
+	{
+		const LinearOctreeNode &n = m_nodes[node];
+		if (~n.childMask & 1 << slot)
+			return LINEAR_OCTREE_NULL;
+		return n.firstChild + PopCount(n.childMask & ((1 << slot) - 1));
+	}
+
+	//leaves stand in for their own children when descending toward smaller nodes
+	inline uint32_t GetChildOrLeaf(uint32_t node, int slot) const
+	{
+		if (node == LINEAR_OCTREE_NULL || IsLeaf(node))
+			return node;
+		return GetChild(node, slot);
+	}
+
+	//queue the sub visits of a task in reverse so they pop in recursive order
+	void PushCellTasks(uint32_t node, vector<TraversalTask> &stack) const;
+	void PushFaceTasks(const TraversalTask &task, bool subdivideFace, vector<TraversalTask> &stack) const;
+	void PushEdgeTasks(const TraversalTask &task, vector<TraversalTask> &stack) const;
+
+	//one step of a traversal, either emits a quad or queues the sub visits
+	void ExpandTask(const TraversalTask &task, vector<TraversalTask> &stack, vector<GLuint> &indexes, float threshold) const;
+	int GetTaskLevel(const TraversalTask &task) const;
+
+	//traverses the top levels and collects the tasks at splitLevel in serial order
+	void SplitTasks(int splitLevel, vector<TraversalTask> &tasks) const;
+
+	void ProcessIndexes(const uint32_t nodes[4], int direction, vector<GLuint> &indexes, float threshold) const;
+
+	//bit i set when the node lies past the owning chunk's boundary along axis i
+	inline int GetSeamSide(uint32_t node) const
+	{
+		const LinearOctreeNode &n = m_nodes[node];
+		return (n.position[0] >= m_seamBoundary.x ? 1 : 0) | (n.position[1] >= m_seamBoundary.y ? 2 : 0) | (n.position[2] >= m_seamBoundary.z ? 4 : 0);
+	}
+
+	//seam region of a leaf edge, 0 if it does not cross the boundary or belongs to a neighbour's seam
+	int GetEdgeRegion(const uint32_t nodes[4]) const;
+
+	void ClusterCell(uint32_t node, float error, MemoryArena &arena, MemoryArena &dataArena);
+	void ClusterIndexes(const uint32_t nodes[4], int direction, int &maxSurfaceIndex, vector<VoxelVertex*> &collectedVertices) const;
+
+public:
+	LinearOctree();
+
+	//leaves must lie at or above origin, leaves larger than the smallest one must be aligned to their size
+	void Build(const vector<Octree*> &leaves, const glm::vec3 &origin);
+
+	void Clear();
+
+	inline bool IsEmpty() const { return m_nodes.empty(); }
+
+	inline int GetNodeCount() const { return m_nodes.size(); }
+
+	//restricts contouring to the edges of one SeamRegion of the chunk the tree is built at,
+	//chunkSize is the world size of that chunk. Cleared by Build
+	void SetSeamRegion(int region, const glm::vec3 &chunkSize);
+
+	//only writes the vertices the leaves resolve to at this error threshold,
+	//a negative threshold keeps every leaf vertex
+	void GenerateVertexBuffer(vector<Vertex> &vertices, float threshold);
+
+	//seam version, needs SetSeamRegion. Leaves of the owning chunk keep the index its body vertex
+	//buffer gave them, only neighbour leaves are written, numbered from firstIndex
+	void GenerateSeamVertexBuffer(vector<Vertex> &vertices, GLuint firstIndex);
+
+	//splits into scheduler tasks below the top levels when a scheduler is given,
+	//the triangle order matches the serial traversal either way
+	void ProcessCell(vector<GLuint> &indexes, float threshold, enki::TaskScheduler *scheduler = nullptr) const;
+
+	void ProcessTask(const TraversalTask &root, vector<GLuint> &indexes, float threshold) const;
+
+	//merges vertices bottom up, new vertices come from arena and their simplification data from dataArena.
+	//cells touching the boundary of a size leaf wide region stay at full detail
+	void ClusterCellBase(float error, const glm::ivec3 &size, MemoryArena &arena, MemoryArena &dataArena);
+};
@@ -0,0 +1,73 @@
+#include "VoxelPlugin.hpp"
+
+MemoryArena::MemoryArena() : m_block(0), m_offset(0), m_largeBytes(0)
+{
+
+}
+
+MemoryArena::~MemoryArena()
+{
+	Release();
+}
+
+void *MemoryArena::Allocate(size_t bytes, size_t alignment)
+{
+	if (bytes == 0)
+		bytes = 1;
+
+	if (bytes > MEMORY_ARENA_BLOCK_SIZE)
+	{
+		char *block = (char*)malloc(bytes);
+		m_largeBlocks.push_back(block);
+		m_largeBytes += bytes;
+		return block;
+	}
+
+	size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+	if (m_block >= m_blocks.size() || offset + bytes > MEMORY_ARENA_BLOCK_SIZE)
+	{
+		//move on to the next block, reusing one left over from a Reset when possible
+		if (m_block < m_blocks.size())
+			m_block++;
+		if (m_block == m_blocks.size())
+			m_blocks.push_back((char*)malloc(MEMORY_ARENA_BLOCK_SIZE));
+		offset = 0;
+	}
+
+	m_offset = offset + bytes;
+	return m_blocks[m_block] + offset;
+}
+
+void MemoryArena::Reset()
+{
+	for (char *block : m_largeBlocks)
+		free(block);
+	m_largeBlocks.clear();
+	m_largeBytes = 0;
+
+	m_block = 0;
+	m_offset = 0;
+}
+
+void MemoryArena::Release()
+{
+	Reset();
+
+	for (char *block : m_blocks)
+		free(block);
+	m_blocks.clear();
+}
+
+void MemoryArena::Swap(MemoryArena &other)
+{
+	m_blocks.swap(other.m_blocks);
+	m_largeBlocks.swap(other.m_largeBlocks);
+	std::swap(m_block, other.m_block);
+	std::swap(m_offset, other.m_offset);
+	std::swap(m_largeBytes, other.m_largeBytes);
+}
+
+size_t MemoryArena::GetMemoryUsage() const
+{
+	return m_blocks.size() * MEMORY_ARENA_BLOCK_SIZE + m_largeBytes;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#define MEMORY_ARENA_BLOCK_SIZE (256 * 1024)
+
+//Bump allocator owned by a chunk. Objects are constructed in place and never
+//destructed, everything is released at once by Reset or when the arena dies,
+//so it should only hold types whose destructors do nothing (Octree, VoxelVertex, VoxelVertexData)
+class MemoryArena
+{
+	vector<char*> m_blocks;      //fixed size blocks, kept across Reset for reuse
+	vector<char*> m_largeBlocks; //requests bigger than a block, freed on Reset
+	size_t m_block;
+	size_t m_offset;
+	size_t m_largeBytes;
+
+	MemoryArena(const MemoryArena &);
+	MemoryArena &operator=(const MemoryArena &);
+
+public:
+	MemoryArena();
+	~MemoryArena();
+
+	void *Allocate(size_t bytes, size_t alignment);
+
+	template<typename T>
+	T *NewArray(size_t count)
+	{
+		T *objects = (T*)Allocate(sizeof(T) * count, alignof(T));
+		for (size_t i = 0; i < count; i++)
+			new (&objects[i]) T();
+		return objects;
+	}
+
+	template<typename T>
+	inline T *New() { return NewArray<T>(1); }
+
+	//invalidates every allocation but keeps the blocks for the next generation
+	void Reset();
+
+	//invalidates every allocation and frees all memory
+	void Release();
+
+	void Swap(MemoryArena &other);
+
+	size_t GetMemoryUsage() const;
+};
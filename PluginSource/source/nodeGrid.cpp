@@ -0,0 +1,142 @@
+#include "VoxelPlugin.hpp"
+
+NodeGrid::NodeGrid()
+{
+
+}
+
+void NodeGrid::BuildRowOffsets()
+{
+	const glm::ivec3 &size = m_cells.GetSize();
+	const int rowWords = m_cells.GetRowWords();
+
+	m_rowOffsets.resize(size.x * size.y + 1);
+
+	int offset = 0;
+	for (int x = 0; x < size.x; x++)
+	{
+		for (int y = 0; y < size.y; y++)
+		{
+			m_rowOffsets[x * size.y + y] = offset;
+
+			const uint64_t *row = m_cells.GetRow(x, y);
+			for (int w = 0; w < rowWords; w++)
+				offset += PopCount(row[w]);
+		}
+	}
+	m_rowOffsets[size.x * size.y] = offset;
+}
+
+void NodeGrid::AddBoundaryNode(const glm::ivec3 &cell, Octree *node)
+{
+	const glm::ivec3 &size = m_cells.GetSize();
+	int low = 0;
+	int high = 0;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (cell[axis] == 0)
+			low |= 1 << axis;
+		if (cell[axis] == size[axis] - 1)
+			high |= 1 << axis;
+	}
+
+	//every non empty subset of the boundary axes
+	const int boundary = low | high;
+	for (int axes = boundary; axes; axes = (axes - 1) & boundary)
+		m_boundaryNodes[axes << 3 | (high & axes)].push_back(node);
+}
+
+void NodeGrid::Build(const glm::ivec3 &size, const vector<glm::ivec3> &cells, Octree *nodes)
+{
+	m_cells.Resize(size);
+	m_nodes.resize(cells.size());
+	for (int i = 0; i < NODE_GRID_BOUNDARY_SLOTS; i++)
+		m_boundaryNodes[i].clear();
+
+	for (size_t i = 0; i < cells.size(); i++)
+	{
+		m_cells.SetSolid(cells[i].x, cells[i].y, cells[i].z);
+		m_nodes[i] = &nodes[i];
+		AddBoundaryNode(cells[i], &nodes[i]);
+	}
+
+	BuildRowOffsets();
+}
+
+void NodeGrid::Clear()
+{
+	m_cells.Reset();
+	m_rowOffsets.clear();
+	m_nodes.clear();
+	for (int i = 0; i < NODE_GRID_BOUNDARY_SLOTS; i++)
+		m_boundaryNodes[i].clear();
+}
+
+Octree *NodeGrid::Find(const glm::ivec3 &cell) const
+{
+	const glm::ivec3 &size = m_cells.GetSize();
+	if (cell.x < 0 || cell.y < 0 || cell.z < 0 || cell.x >= size.x || cell.y >= size.y || cell.z >= size.z)
+		return nullptr;
+
+	if (!m_cells.GetMaterial(cell.x, cell.y, cell.z))
+		return nullptr;
+
+	//rank of the cell within its row
+	const uint64_t *row = m_cells.GetRow(cell.x, cell.y);
+	const int word = cell.z >> 6;
+	int slot = m_rowOffsets[cell.x * size.y + cell.y];
+	for (int w = 0; w < word; w++)
+		slot += PopCount(row[w]);
+	slot += PopCount(row[word] & RangeMask(0, cell.z & 63));
+
+	return m_nodes[slot];
+}
+
+void NodeGrid::RemoveInactive()
+{
+	const glm::ivec3 &size = m_cells.GetSize();
+	const int rowWords = m_cells.GetRowWords();
+	int slot = 0;
+	int kept = 0;
+	for (int i = 0; i < NODE_GRID_BOUNDARY_SLOTS; i++)
+		m_boundaryNodes[i].clear();
+
+	for (int x = 0; x < size.x; x++)
+	{
+		for (int y = 0; y < size.y; y++)
+		{
+			uint64_t *row = m_cells.GetRow(x, y);
+			for (int w = 0; w < rowWords; w++)
+			{
+				uint64_t bits = row[w];
+				while (bits)
+				{
+					int bit = CountTrailingZeros(bits);
+					bits &= bits - 1;
+
+					Octree *node = m_nodes[slot++];
+					if (node->m_flag & OCTREE_ACTIVE)
+					{
+						m_nodes[kept++] = node;
+						AddBoundaryNode(glm::ivec3(x, y, w * 64 + bit), node);
+					}
+					else
+						row[w] &= ~((uint64_t)1 << bit);
+				}
+			}
+		}
+	}
+
+	m_nodes.resize(kept);
+	BuildRowOffsets();
+}
+
+size_t NodeGrid::GetMemoryUsage() const
+{
+	size_t total = m_cells.GetMemoryUsage();
+	total += m_rowOffsets.capacity() * sizeof(int);
+	total += m_nodes.capacity() * sizeof(Octree*);
+	for (int i = 0; i < NODE_GRID_BOUNDARY_SLOTS; i++)
+		total += m_boundaryNodes[i].capacity() * sizeof(Octree*);
+	return total;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#define NODE_GRID_BOUNDARY_SLOTS 64 //one list per (axes << 3) | high sides
+
+//Dense per chunk index of leaf nodes keyed by local integer cell position.
+//Active cells are marked in a bitmap and nodes are stored in x, y, z order,
+//so a cell's slot is its row offset plus the set bits below it in the row
+class NodeGrid
+{
+	OccupancyGrid m_cells;
+	vector<int> m_rowOffsets;
+	vector<Octree*> m_nodes;
+	vector<Octree*> m_boundaryNodes[NODE_GRID_BOUNDARY_SLOTS];
+
+	void BuildRowOffsets();
+
+	//files a node under every face, edge and corner of the grid its cell lies on
+	void AddBoundaryNode(const glm::ivec3 &cell, Octree *node);
+
+public:
+	NodeGrid();
+
+	//cells must be sorted in x, y, z order, nodes[i] belongs to cells[i]
+	void Build(const glm::ivec3 &size, const vector<glm::ivec3> &cells, Octree *nodes);
+
+	void Clear();
+
+	Octree *Find(const glm::ivec3 &cell) const;
+
+	//drops nodes that did not produce any vertices
+	void RemoveInactive();
+
+	//nodes in the layer at the low or high end of every axis in axes, bit i of high picks the high
+	//end of axis i. One axis gives a face, two an edge and three a corner, kept up to date by
+	//Build and RemoveInactive so seams never scan the grid
+	inline const vector<Octree*> &GetBoundaryNodes(int axes, int high) const { return m_boundaryNodes[axes << 3 | (high & axes)]; }
+
+	inline const vector<Octree*> &GetNodes() const { return m_nodes; }
+
+	inline int GetNodeCount() const { return m_nodes.size(); }
+
+	size_t GetMemoryUsage() const;
+};
@@ -0,0 +1,111 @@
+#include "VoxelPlugin.hpp"
+
+OccupancyGrid::OccupancyGrid() : m_size(0), m_rowWords(0)
+{
+
+}
+
+void OccupancyGrid::Resize(const glm::ivec3 &size)
+{
+	m_size = size;
+	m_rowWords = (size.z + 63) / 64;
+	m_words.assign(size.x * size.y * m_rowWords, 0);
+}
+
+void OccupancyGrid::Reset()
+{
+	m_size = glm::ivec3(0);
+	m_rowWords = 0;
+	m_words.clear();
+}
+
+void OccupancyGrid::Swap(OccupancyGrid &other)
+{
+	std::swap(m_size, other.m_size);
+	std::swap(m_rowWords, other.m_rowWords);
+	m_words.swap(other.m_words);
+}
+
+void OccupancyGrid::FindActiveCells(vector<glm::ivec3> &cells, vector<int> &corners) const
+{
+	const int cellsZ = m_size.z - 1;
+
+	for (int x = 0; x < m_size.x - 1; x++)
+	{
+		for (int y = 0; y < m_size.y - 1; y++)
+		{
+			const uint64_t *rows[4] = { GetRow(x, y), GetRow(x, y + 1), GetRow(x + 1, y), GetRow(x + 1, y + 1) };
+
+			for (int w = 0; w < m_rowWords; w++)
+			{
+				//c[i] holds corner i (see CHILD_MIN_OFFSETS) of 64 cells at once
+				uint64_t c[8];
+				for (int r = 0; r < 4; r++)
+				{
+					c[r * 2] = rows[r][w];
+					c[r * 2 + 1] = ShiftNext(rows[r], w, m_rowWords);
+				}
+
+				uint64_t any = c[0] | c[1] | c[2] | c[3] | c[4] | c[5] | c[6] | c[7];
+				uint64_t all = c[0] & c[1] & c[2] & c[3] & c[4] & c[5] & c[6] & c[7];
+
+				//skip cells that are all air or all solid
+				uint64_t active = any & ~all & RangeMask(w, cellsZ);
+				while (active)
+				{
+					int bit = CountTrailingZeros(active);
+					active &= active - 1;
+
+					int code = 0;
+					for (int i = 0; i < 8; i++)
+						code |= (int)((c[i] >> bit) & 1) << i;
+
+					cells.push_back(glm::ivec3(x, y, w * 64 + bit));
+					corners.push_back(code);
+				}
+			}
+		}
+	}
+}
+
+void OccupancyGrid::FindCrossingEdges(vector<glm::ivec3> &edges, vector<int> &axes) const
+{
+	for (int x = 0; x < m_size.x; x++)
+	{
+		for (int y = 0; y < m_size.y; y++)
+		{
+			const uint64_t *row = GetRow(x, y);
+			const uint64_t *rowX = x + 1 < m_size.x ? GetRow(x + 1, y) : nullptr;
+			const uint64_t *rowY = y + 1 < m_size.y ? GetRow(x, y + 1) : nullptr;
+
+			for (int w = 0; w < m_rowWords; w++)
+			{
+				uint64_t crossings[3];
+				crossings[0] = rowX ? (row[w] ^ rowX[w]) & RangeMask(w, m_size.z) : 0;
+				crossings[1] = rowY ? (row[w] ^ rowY[w]) & RangeMask(w, m_size.z) : 0;
+				crossings[2] = (row[w] ^ ShiftNext(row, w, m_rowWords)) & RangeMask(w, m_size.z - 1);
+
+				uint64_t any = crossings[0] | crossings[1] | crossings[2];
+				while (any)
+				{
+					int bit = CountTrailingZeros(any);
+					any &= any - 1;
+
+					for (int axis = 0; axis < 3; axis++)
+					{
+						if ((crossings[axis] >> bit) & 1)
+						{
+							edges.push_back(glm::ivec3(x, y, w * 64 + bit));
+							axes.push_back(axis);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+size_t OccupancyGrid::GetMemoryUsage() const
+{
+	return m_words.capacity() * sizeof(uint64_t);
+}
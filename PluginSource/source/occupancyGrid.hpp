@@ -0,0 +1,103 @@
+#pragma once
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//word must not be zero
+static inline int CountTrailingZeros(uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return (int)index;
+#elif defined(_MSC_VER)
+	//32 bit targets only have the 32 bit scan
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)word))
+		return (int)index;
+	_BitScanForward(&index, (unsigned long)(word >> 32));
+	return (int)index + 32;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+static inline int PopCount(uint64_t word)
+{
+#ifdef _MSC_VER
+	//__popcnt64 needs the POPCNT instruction, which is not part of the x64 baseline
+	word = word - ((word >> 1) & 0x5555555555555555ull);
+	word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+	word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return (int)((word * 0x0101010101010101ull) >> 56);
+#else
+	return __builtin_popcountll(word);
+#endif
+}
+
+//mask of the bits in word w that hold samples below end
+static inline uint64_t RangeMask(int w, int end)
+{
+	int count = end - w * 64;
+	if (count <= 0) return 0;
+	if (count >= 64) return ~(uint64_t)0;
+	return ((uint64_t)1 << count) - 1;
+}
+
+//the row shifted down one sample, so bit z holds sample z + 1
+static inline uint64_t ShiftNext(const uint64_t *row, int w, int rowWords)
+{
+	uint64_t next = w + 1 < rowWords ? row[w + 1] << 63 : 0;
+	return (row[w] >> 1) | next;
+}
+
+//Bit packed material grid, one bit per sample (set = MATERIAL_SOLID).
+//Rows run along z and are packed into 64 bit words, rows are indexed by (x, y)
+class OccupancyGrid
+{
+	glm::ivec3 m_size; //samples per axis
+	int m_rowWords;
+	vector<uint64_t> m_words;
+
+public:
+	OccupancyGrid();
+
+	//resizes the grid and clears every sample to MATERIAL_AIR
+	void Resize(const glm::ivec3 &size);
+
+	//empties the grid, its storage is kept for the next Resize
+	void Reset();
+
+	void Swap(OccupancyGrid &other);
+
+	inline const glm::ivec3 &GetSize() const { return m_size; }
+
+	inline int GetMaterial(int x, int y, int z) const
+	{
+		return (GetRow(x, y)[z >> 6] >> (z & 63)) & 1;
+	}
+
+	inline void SetSolid(int x, int y, int z)
+	{
+		GetRow(x, y)[z >> 6] |= (uint64_t)1 << (z & 63);
+	}
+
+	inline void SetAir(int x, int y, int z)
+	{
+		GetRow(x, y)[z >> 6] &= ~((uint64_t)1 << (z & 63));
+	}
+
+	inline int GetRowWords() const { return m_rowWords; }
+
+	inline uint64_t *GetRow(int x, int y) { return &m_words[(x * m_size.y + y) * m_rowWords]; }
+	inline const uint64_t *GetRow(int x, int y) const { return &m_words[(x * m_size.y + y) * m_rowWords]; }
+
+	//emits local cell position and 8 bit corner code of every cell with a sign change
+	void FindActiveCells(vector<glm::ivec3> &cells, vector<int> &corners) const;
+
+	//emits the start sample and axis (0 = x, 1 = y, 2 = z) of every edge with a sign change
+	void FindCrossingEdges(vector<glm::ivec3> &edges, vector<int> &axes) const;
+
+	size_t GetMemoryUsage() const;
+};
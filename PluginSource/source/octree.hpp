@@ -24,56 +24,26 @@ const glm::vec3 CHILD_MIN_OFFSETS[] =
 	glm::vec3(1, 1, 1),
 };
 
-struct EdgeInfo
-{
-	EdgeInfo() {};
-	EdgeInfo(glm::vec3 p, glm::vec3 n) :pos(p), normal(n) {};
-	glm::vec3 pos;
-	glm::vec3 normal;
-};
-
-
 class Octree;
 
 
-void FindEdgeCrossing(Octree *node, const unordered_map<glm::vec3, EdgeInfo> &hermite_map);
-
-Octree * BottomUpTreeGen(const unordered_map<glm::vec3, Octree *> &unordered_map, const glm::vec3 &chunkPos);
-Octree * BottomUpTreeGen(const vector<Octree*> &nodes, const glm::vec3 &chunkPos);
+void FindEdgeCrossing(Octree *node, const HermiteGrid &hermite, MemoryArena &arena, MemoryArena &dataArena);
+//solves the qef of every leaf vertex in one simd batch
+void SolveLeafVertices(const vector<Octree*> &leaves, QEFBatch &batch);
 
+//Leaf cell of a chunk. Inner nodes and traversal live in LinearOctree
 class Octree
 {
 public:
-	int m_index;
-	unsigned char m_child_index;
 	unsigned char m_corners;
 	unsigned char m_vertex_count;
+	char m_flag;
 
-	Octree * m_children[8];
 	VoxelVertex *m_vertices;
 
-	char m_flag;
-	char m_childMask;
-
 	int m_size;
 	glm::vec3 m_minPos;
 public:
 	Octree();
-	~Octree();
 	void InitNode(glm::vec3 minPos, int size, int corners);
-	void DestroyNode();
-
-	
-	void GenerateVertexBuffer(std::vector<VoxelVertex>& v_out);
-
-	void ProcessCell(std::vector<GLuint>& indexes, const float threshold);
-	void ProcessFace(Octree ** nodes, int direction, std::vector<GLuint>& indexes, float threshold);
-	void ProcessEdge(Octree ** nodes, int direction, std::vector<GLuint>& indexes, float threshold);
-	void ProcessIndexes(Octree ** nodes, int direction, std::vector<GLuint>& indexes, float threshold);
-	void ClusterCellBase(float error);
-	void ClusterCell(float error);
-	void ClusterFace(Octree ** nodes, int direction, int & surface_index, std::vector<VoxelVertex*>& collected_vertices);
-	void ClusterEdge(Octree ** nodes, int direction, int & surface_index, std::vector<VoxelVertex*>& collected_vertices);
-	void ClusterIndexes(Octree ** nodes, int direction, int & max_surface_index, std::vector<VoxelVertex*>& collected_vertices);
-	void AssignSurface(std::vector<VoxelVertex*>& vertices, int from, int to);
-};
\ No newline at end of file
+};
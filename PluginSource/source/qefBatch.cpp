@@ -0,0 +1,125 @@
+#include "VoxelPlugin.hpp"
+
+QEFBatch::QEFBatch() : m_count(0)
+{
+}
+
+void QEFBatch::Clear()
+{
+	for (int f = 0; f < QEF_FIELD_COUNT; f++)
+		m_fields[f].clear();
+	for (int i = 0; i < 3; i++)
+		m_position[i].clear();
+	m_error.clear();
+	m_count = 0;
+}
+
+int QEFBatch::Add(const QEFData &data)
+{
+	m_fields[QEF_ATA_00].push_back(data.ata_00);
+	m_fields[QEF_ATA_01].push_back(data.ata_01);
+	m_fields[QEF_ATA_02].push_back(data.ata_02);
+	m_fields[QEF_ATA_11].push_back(data.ata_11);
+	m_fields[QEF_ATA_12].push_back(data.ata_12);
+	m_fields[QEF_ATA_22].push_back(data.ata_22);
+	m_fields[QEF_ATB_X].push_back(data.atb_x);
+	m_fields[QEF_ATB_Y].push_back(data.atb_y);
+	m_fields[QEF_ATB_Z].push_back(data.atb_z);
+	m_fields[QEF_MASS_X].push_back(data.massPoint_x);
+	m_fields[QEF_MASS_Y].push_back(data.massPoint_y);
+	m_fields[QEF_MASS_Z].push_back(data.massPoint_z);
+	m_fields[QEF_NUM_POINTS].push_back((float)data.numPoints);
+
+	return m_count++;
+}
+
+static void SolveQEFBatchScalar(const QEFBatchArrays &arrays, float svdTol, int sweeps, float pinvTol)
+{
+	const float *const *f = arrays.fields;
+	for (int i = 0; i < arrays.count; i++)
+	{
+		QEFSolver qef;
+		qef.add(QEFData(f[QEF_ATA_00][i], f[QEF_ATA_01][i], f[QEF_ATA_02][i],
+			f[QEF_ATA_11][i], f[QEF_ATA_12][i], f[QEF_ATA_22][i],
+			f[QEF_ATB_X][i], f[QEF_ATB_Y][i], f[QEF_ATB_Z][i], 0,
+			f[QEF_MASS_X][i], f[QEF_MASS_Y][i], f[QEF_MASS_Z][i],
+			(int)f[QEF_NUM_POINTS][i]));
+
+		Vec3 p;
+		arrays.error[i] = qef.solve(p, svdTol, sweeps, pinvTol);
+		arrays.position[0][i] = p.x;
+		arrays.position[1][i] = p.y;
+		arrays.position[2][i] = p.z;
+	}
+}
+
+void QEFBatch::Solve(float svdTol, int sweeps, float pinvTol)
+{
+	if (m_count == 0)
+		return;
+
+	//pad with a well formed system so the last lane group never reads past the end
+	const int padded = (m_count + QEF_BATCH_WIDTH - 1) / QEF_BATCH_WIDTH * QEF_BATCH_WIDTH;
+	for (int f = 0; f < QEF_FIELD_COUNT; f++)
+		m_fields[f].resize(padded, f == QEF_NUM_POINTS ? 1.f : 0.f);
+	for (int i = 0; i < 3; i++)
+		m_position[i].resize(padded);
+	m_error.resize(padded);
+
+	QEFBatchArrays arrays;
+	for (int f = 0; f < QEF_FIELD_COUNT; f++)
+		arrays.fields[f] = m_fields[f].data();
+	for (int i = 0; i < 3; i++)
+		arrays.position[i] = m_position[i].data();
+	arrays.error = m_error.data();
+	arrays.count = padded;
+
+	switch (GetLaneCount())
+	{
+#ifdef FN_COMPILE_AVX512
+	case 16:
+		SolveQEFBatchAVX512(arrays, svdTol, sweeps, pinvTol);
+		break;
+#endif
+#ifdef FN_COMPILE_AVX2
+	case 8:
+		SolveQEFBatchAVX2(arrays, svdTol, sweeps, pinvTol);
+		break;
+#endif
+#ifdef FN_COMPILE_SSE2
+	case 4:
+		SolveQEFBatchSSE2(arrays, svdTol, sweeps, pinvTol);
+		break;
+#endif
+	default:
+		arrays.count = m_count;
+		SolveQEFBatchScalar(arrays, svdTol, sweeps, pinvTol);
+		break;
+	}
+
+	//drop the padding so more systems can be added after solving
+	for (int f = 0; f < QEF_FIELD_COUNT; f++)
+		m_fields[f].resize(m_count);
+	for (int i = 0; i < 3; i++)
+		m_position[i].resize(m_count);
+	m_error.resize(m_count);
+}
+
+int QEFBatch::GetLaneCount()
+{
+	const int level = FastNoiseSIMD::GetSIMDLevel();
+
+#ifdef FN_COMPILE_AVX512
+	if (level >= FN_AVX512 && level < FN_NEON)
+		return 16;
+#endif
+#ifdef FN_COMPILE_AVX2
+	if (level >= FN_AVX2 && level < FN_NEON)
+		return 8;
+#endif
+#ifdef FN_COMPILE_SSE2
+	if (level >= FN_SSE2 && level < FN_NEON)
+		return 4;
+#endif
+	return 1;
+}
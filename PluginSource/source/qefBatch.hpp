@@ -0,0 +1,65 @@
+#pragma once
+
+//widest lane group, the arrays are padded to a multiple of it
+#define QEF_BATCH_WIDTH 16
+
+enum QEFBatchField
+{
+	QEF_ATA_00 = 0,
+	QEF_ATA_01,
+	QEF_ATA_02,
+	QEF_ATA_11,
+	QEF_ATA_12,
+	QEF_ATA_22,
+	QEF_ATB_X,
+	QEF_ATB_Y,
+	QEF_ATB_Z,
+	QEF_MASS_X,
+	QEF_MASS_Y,
+	QEF_MASS_Z,
+	QEF_NUM_POINTS,
+	QEF_FIELD_COUNT
+};
+
+//structure of arrays view handed to the simd kernels
+struct QEFBatchArrays
+{
+	const float *fields[QEF_FIELD_COUNT];
+	float *position[3];
+	float *error;
+	int count;
+};
+
+//per instruction set kernels, compiled in qefBatch_<level>.cpp
+void SolveQEFBatchSSE2(const QEFBatchArrays &arrays, float svdTol, int sweeps, float pinvTol);
+void SolveQEFBatchAVX2(const QEFBatchArrays &arrays, float svdTol, int sweeps, float pinvTol);
+void SolveQEFBatchAVX512(const QEFBatchArrays &arrays, float svdTol, int sweeps, float pinvTol);
+
+//Collects QEFs in SoA layout and solves them 4, 8 or 16 at a time depending on
+//the simd level FastNoiseSIMD detected. Results match QEFSolver::solve
+class QEFBatch
+{
+	vector<float> m_fields[QEF_FIELD_COUNT];
+	vector<float> m_position[3];
+	vector<float> m_error;
+	int m_count;
+
+public:
+	QEFBatch();
+
+	void Clear();
+
+	//returns the index of the system
+	int Add(const QEFData &data);
+
+	inline int GetCount() const { return m_count; }
+
+	void Solve(float svdTol, int sweeps, float pinvTol);
+
+	inline glm::vec3 GetPosition(int i) const { return glm::vec3(m_position[0][i], m_position[1][i], m_position[2][i]); }
+
+	inline float GetError(int i) const { return m_error[i]; }
+
+	//systems solved per instruction on this cpu
+	static int GetLaneCount();
+};
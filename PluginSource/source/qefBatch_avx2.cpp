@@ -0,0 +1,41 @@
+#include "VoxelPlugin.hpp"
+
+//like FastNoiseSIMD_avx2.cpp this file needs avx code generation, it only runs when the cpu supports it
+#ifdef FN_COMPILE_AVX2
+#ifndef __AVX__
+#ifdef __GNUC__
+#error To compile AVX2 add build command "-mavx2" on qefBatch_avx2.cpp, or remove "#define FN_COMPILE_AVX2" from FastNoiseSIMD.h
+#else
+#error To compile AVX2 set C++ code generation to use /arch:AVX(2) on qefBatch_avx2.cpp, or remove "#define FN_COMPILE_AVX2" from FastNoiseSIMD.h
+#endif
+#endif
+#include <immintrin.h>
+
+#define QEF_FLOAT __m256
+#define QEF_MASK __m256
+#define QEF_WIDTH 8
+#define QEF_KERNEL_NAME SolveQEFBatchAVX2
+
+#define QEF_LOAD(p) _mm256_loadu_ps(p)
+#define QEF_STORE(p, a) _mm256_storeu_ps(p, a)
+#define QEF_SET(a) _mm256_set1_ps(a)
+#define QEF_ADD(a, b) _mm256_add_ps(a, b)
+#define QEF_SUB(a, b) _mm256_sub_ps(a, b)
+#define QEF_MUL(a, b) _mm256_mul_ps(a, b)
+#define QEF_DIV(a, b) _mm256_div_ps(a, b)
+#define QEF_SQRT(a) _mm256_sqrt_ps(a)
+#define QEF_ABS(a) _mm256_andnot_ps(_mm256_set1_ps(-0.f), a)
+
+#define QEF_LESS(a, b) _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define QEF_GREATER(a, b) _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define QEF_GREATER_EQUAL(a, b) _mm256_cmp_ps(a, b, _CMP_GE_OQ)
+#define QEF_NOT_EQUAL(a, b) _mm256_cmp_ps(a, b, _CMP_NEQ_UQ)
+#define QEF_IS_NAN(a) _mm256_cmp_ps(a, a, _CMP_UNORD_Q)
+
+#define QEF_MASK_AND(a, b) _mm256_and_ps(a, b)
+#define QEF_MASK_OR(a, b) _mm256_or_ps(a, b)
+#define QEF_MASK_ANY(m) (_mm256_movemask_ps(m) != 0)
+#define QEF_BLEND(a, b, m) _mm256_blendv_ps(a, b, m)
+
+#include "qefBatch_internal.hpp"
+#endif
@@ -0,0 +1,41 @@
+#include "VoxelPlugin.hpp"
+
+//like FastNoiseSIMD_avx512.cpp this file needs avx512 code generation, it only runs when the cpu supports it
+#ifdef FN_COMPILE_AVX512
+#ifndef __AVX512F__
+#ifdef __GNUC__
+#error To compile AVX512 add build command "-mavx512f" on qefBatch_avx512.cpp, or remove "#define FN_COMPILE_AVX512" from FastNoiseSIMD.h
+#else
+#error To compile AVX512 set C++ code generation to use /arch:AVX512 on qefBatch_avx512.cpp, or remove "#define FN_COMPILE_AVX512" from FastNoiseSIMD.h
+#endif
+#endif
+#include <immintrin.h>
+
+#define QEF_FLOAT __m512
+#define QEF_MASK __mmask16
+#define QEF_WIDTH 16
+#define QEF_KERNEL_NAME SolveQEFBatchAVX512
+
+#define QEF_LOAD(p) _mm512_loadu_ps(p)
+#define QEF_STORE(p, a) _mm512_storeu_ps(p, a)
+#define QEF_SET(a) _mm512_set1_ps(a)
+#define QEF_ADD(a, b) _mm512_add_ps(a, b)
+#define QEF_SUB(a, b) _mm512_sub_ps(a, b)
+#define QEF_MUL(a, b) _mm512_mul_ps(a, b)
+#define QEF_DIV(a, b) _mm512_div_ps(a, b)
+#define QEF_SQRT(a) _mm512_sqrt_ps(a)
+#define QEF_ABS(a) _mm512_abs_ps(a)
+
+#define QEF_LESS(a, b) _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ)
+#define QEF_GREATER(a, b) _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ)
+#define QEF_GREATER_EQUAL(a, b) _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ)
+#define QEF_NOT_EQUAL(a, b) _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ)
+#define QEF_IS_NAN(a) _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q)
+
+#define QEF_MASK_AND(a, b) ((QEF_MASK)((a) & (b)))
+#define QEF_MASK_OR(a, b) ((QEF_MASK)((a) | (b)))
+#define QEF_MASK_ANY(m) ((m) != 0)
+#define QEF_BLEND(a, b, m) _mm512_mask_blend_ps(m, a, b)
+
+#include "qefBatch_internal.hpp"
+#endif
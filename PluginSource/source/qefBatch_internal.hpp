@@ -0,0 +1,228 @@
+#pragma once
+
+//Lane generic QEF solve, included once per instruction set by qefBatch_<level>.cpp
+//after defining the QEF_* vector macros and QEF_KERNEL_NAME. Every operation
+//mirrors QEFSolver::solve and Svd::solveSymmetric in the same order so each lane
+//produces the same bits as the scalar solver
+
+//fused multiply adds round differently, keep them out of the lane math
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+struct QEFLanes
+{
+	QEF_FLOAT m00, m01, m02, m11, m12, m22;
+};
+
+static inline QEF_FLOAT QEFSquare(QEF_FLOAT a)
+{
+	return QEF_MUL(a, a);
+}
+
+static inline QEF_FLOAT QEFPinv(QEF_FLOAT x, QEF_FLOAT tol)
+{
+	const QEF_FLOAT inv = QEF_DIV(QEF_SET(1.f), x);
+	const QEF_MASK small = QEF_MASK_OR(QEF_LESS(QEF_ABS(x), tol), QEF_LESS(QEF_ABS(inv), tol));
+	return QEF_BLEND(inv, QEF_SET(0.f), small);
+}
+
+//calcSymmetricGivensCoefficients for lanes where a_pq is non zero
+static inline void QEFGivens(QEF_FLOAT app, QEF_FLOAT apq, QEF_FLOAT aqq, QEF_FLOAT &c, QEF_FLOAT &s)
+{
+	const QEF_FLOAT one = QEF_SET(1.f);
+	const QEF_FLOAT tau = QEF_DIV(QEF_SUB(aqq, app), QEF_MUL(QEF_SET(2.f), apq));
+	const QEF_FLOAT stt = QEF_SQRT(QEF_ADD(one, QEF_MUL(tau, tau)));
+	const QEF_FLOAT denom = QEF_BLEND(QEF_SUB(tau, stt), QEF_ADD(tau, stt), QEF_GREATER_EQUAL(tau, QEF_SET(0.f)));
+	const QEF_FLOAT tan = QEF_DIV(one, denom);
+	c = QEF_DIV(one, QEF_SQRT(QEF_ADD(one, QEF_MUL(tan, tan))));
+	s = QEF_MUL(tan, c);
+}
+
+//rotated pair of a column of v, svd.cpp zeroes the givens coefficients before rotating v
+static inline void QEFRotateV(QEF_FLOAT &a, QEF_FLOAT &b, QEF_MASK mask)
+{
+	const QEF_FLOAT c = QEF_SET(0.f), s = QEF_SET(0.f);
+	const QEF_FLOAT ra = QEF_SUB(QEF_MUL(c, a), QEF_MUL(s, b));
+	const QEF_FLOAT rb = QEF_ADD(QEF_MUL(s, a), QEF_MUL(c, b));
+	a = QEF_BLEND(a, ra, mask);
+	b = QEF_BLEND(b, rb, mask);
+}
+
+static inline void QEFRotate01(QEFLanes &m, QEF_FLOAT v[9], QEF_MASK active)
+{
+	const QEF_MASK mask = QEF_MASK_AND(active, QEF_NOT_EQUAL(m.m01, QEF_SET(0.f)));
+	if (!QEF_MASK_ANY(mask))
+		return;
+
+	QEF_FLOAT c, s;
+	QEFGivens(m.m00, m.m01, m.m11, c, s);
+	const QEF_FLOAT cc = QEF_MUL(c, c);
+	const QEF_FLOAT ss = QEF_MUL(s, s);
+	const QEF_FLOAT mix = QEF_MUL(QEF_MUL(QEF_MUL(QEF_SET(2.f), c), s), m.m01);
+
+	const QEF_FLOAT m00 = QEF_ADD(QEF_SUB(QEF_MUL(cc, m.m00), mix), QEF_MUL(ss, m.m11));
+	const QEF_FLOAT m02 = QEF_SUB(QEF_MUL(c, m.m02), QEF_MUL(s, m.m12));
+	const QEF_FLOAT m11 = QEF_ADD(QEF_ADD(QEF_MUL(ss, m.m00), mix), QEF_MUL(cc, m.m11));
+	const QEF_FLOAT m12 = QEF_ADD(QEF_MUL(s, m.m02), QEF_MUL(c, m.m12));
+
+	m.m00 = QEF_BLEND(m.m00, m00, mask);
+	m.m01 = QEF_BLEND(m.m01, QEF_SET(0.f), mask);
+	m.m02 = QEF_BLEND(m.m02, m02, mask);
+	m.m11 = QEF_BLEND(m.m11, m11, mask);
+	m.m12 = QEF_BLEND(m.m12, m12, mask);
+
+	for (int r = 0; r < 3; r++)
+		QEFRotateV(v[r * 3 + 0], v[r * 3 + 1], mask);
+}
+
+static inline void QEFRotate02(QEFLanes &m, QEF_FLOAT v[9], QEF_MASK active)
+{
+	const QEF_MASK mask = QEF_MASK_AND(active, QEF_NOT_EQUAL(m.m02, QEF_SET(0.f)));
+	if (!QEF_MASK_ANY(mask))
+		return;
+
+	QEF_FLOAT c, s;
+	QEFGivens(m.m00, m.m02, m.m22, c, s);
+	const QEF_FLOAT cc = QEF_MUL(c, c);
+	const QEF_FLOAT ss = QEF_MUL(s, s);
+	const QEF_FLOAT mix = QEF_MUL(QEF_MUL(QEF_MUL(QEF_SET(2.f), c), s), m.m02);
+
+	const QEF_FLOAT m00 = QEF_ADD(QEF_SUB(QEF_MUL(cc, m.m00), mix), QEF_MUL(ss, m.m22));
+	const QEF_FLOAT m01 = QEF_SUB(QEF_MUL(c, m.m01), QEF_MUL(s, m.m12));
+	const QEF_FLOAT m12 = QEF_ADD(QEF_MUL(s, m.m01), QEF_MUL(c, m.m12));
+	const QEF_FLOAT m22 = QEF_ADD(QEF_ADD(QEF_MUL(ss, m.m00), mix), QEF_MUL(cc, m.m22));
+
+	m.m00 = QEF_BLEND(m.m00, m00, mask);
+	m.m01 = QEF_BLEND(m.m01, m01, mask);
+	m.m02 = QEF_BLEND(m.m02, QEF_SET(0.f), mask);
+	m.m12 = QEF_BLEND(m.m12, m12, mask);
+	m.m22 = QEF_BLEND(m.m22, m22, mask);
+
+	for (int r = 0; r < 3; r++)
+		QEFRotateV(v[r * 3 + 0], v[r * 3 + 2], mask);
+}
+
+static inline void QEFRotate12(QEFLanes &m, QEF_FLOAT v[9], QEF_MASK active)
+{
+	const QEF_MASK mask = QEF_MASK_AND(active, QEF_NOT_EQUAL(m.m12, QEF_SET(0.f)));
+	if (!QEF_MASK_ANY(mask))
+		return;
+
+	QEF_FLOAT c, s;
+	QEFGivens(m.m11, m.m12, m.m22, c, s);
+	const QEF_FLOAT cc = QEF_MUL(c, c);
+	const QEF_FLOAT ss = QEF_MUL(s, s);
+	const QEF_FLOAT mix = QEF_MUL(QEF_MUL(QEF_MUL(QEF_SET(2.f), c), s), m.m12);
+
+	const QEF_FLOAT m01 = QEF_SUB(QEF_MUL(c, m.m01), QEF_MUL(s, m.m02));
+	const QEF_FLOAT m02 = QEF_ADD(QEF_MUL(s, m.m01), QEF_MUL(c, m.m02));
+	const QEF_FLOAT m11 = QEF_ADD(QEF_SUB(QEF_MUL(cc, m.m11), mix), QEF_MUL(ss, m.m22));
+	const QEF_FLOAT m22 = QEF_ADD(QEF_ADD(QEF_MUL(ss, m.m11), mix), QEF_MUL(cc, m.m22));
+
+	m.m01 = QEF_BLEND(m.m01, m01, mask);
+	m.m02 = QEF_BLEND(m.m02, m02, mask);
+	m.m11 = QEF_BLEND(m.m11, m11, mask);
+	m.m12 = QEF_BLEND(m.m12, QEF_SET(0.f), mask);
+	m.m22 = QEF_BLEND(m.m22, m22, mask);
+
+	for (int r = 0; r < 3; r++)
+		QEFRotateV(v[r * 3 + 1], v[r * 3 + 2], mask);
+}
+
+//entry (r, k) of v * diag(d) * v^T
+static inline QEF_FLOAT QEFPinvEntry(const QEF_FLOAT v[9], int r, int k, const QEF_FLOAT d[3])
+{
+	QEF_FLOAT sum = QEF_MUL(QEF_MUL(v[r * 3 + 0], d[0]), v[k * 3 + 0]);
+	sum = QEF_ADD(sum, QEF_MUL(QEF_MUL(v[r * 3 + 1], d[1]), v[k * 3 + 1]));
+	return QEF_ADD(sum, QEF_MUL(QEF_MUL(v[r * 3 + 2], d[2]), v[k * 3 + 2]));
+}
+
+//row of a symmetric matrix times a vector
+static inline QEF_FLOAT QEFDot(QEF_FLOAT a0, QEF_FLOAT a1, QEF_FLOAT a2, QEF_FLOAT x, QEF_FLOAT y, QEF_FLOAT z)
+{
+	return QEF_ADD(QEF_ADD(QEF_MUL(a0, x), QEF_MUL(a1, y)), QEF_MUL(a2, z));
+}
+
+void QEF_KERNEL_NAME(const QEFBatchArrays &arrays, float svdTol, int sweeps, float pinvTol)
+{
+	const float *const *f = arrays.fields;
+	const QEF_FLOAT zero = QEF_SET(0.f);
+
+	for (int i = 0; i < arrays.count; i += QEF_WIDTH)
+	{
+		QEFLanes ata;
+		ata.m00 = QEF_LOAD(f[QEF_ATA_00] + i);
+		ata.m01 = QEF_LOAD(f[QEF_ATA_01] + i);
+		ata.m02 = QEF_LOAD(f[QEF_ATA_02] + i);
+		ata.m11 = QEF_LOAD(f[QEF_ATA_11] + i);
+		ata.m12 = QEF_LOAD(f[QEF_ATA_12] + i);
+		ata.m22 = QEF_LOAD(f[QEF_ATA_22] + i);
+
+		//solve around the mass point
+		const QEF_FLOAT invPoints = QEF_DIV(QEF_SET(1.f), QEF_LOAD(f[QEF_NUM_POINTS] + i));
+		const QEF_FLOAT mx = QEF_MUL(QEF_LOAD(f[QEF_MASS_X] + i), invPoints);
+		const QEF_FLOAT my = QEF_MUL(QEF_LOAD(f[QEF_MASS_Y] + i), invPoints);
+		const QEF_FLOAT mz = QEF_MUL(QEF_LOAD(f[QEF_MASS_Z] + i), invPoints);
+
+		const QEF_FLOAT bx = QEF_SUB(QEF_LOAD(f[QEF_ATB_X] + i), QEFDot(ata.m00, ata.m01, ata.m02, mx, my, mz));
+		const QEF_FLOAT by = QEF_SUB(QEF_LOAD(f[QEF_ATB_Y] + i), QEFDot(ata.m01, ata.m11, ata.m12, mx, my, mz));
+		const QEF_FLOAT bz = QEF_SUB(QEF_LOAD(f[QEF_ATB_Z] + i), QEFDot(ata.m02, ata.m12, ata.m22, mx, my, mz));
+
+		//jacobi sweeps, lanes drop out once their off diagonal is small enough
+		QEFLanes vtav = ata;
+		QEF_FLOAT v[9] = { QEF_SET(1.f), zero, zero, zero, QEF_SET(1.f), zero, zero, zero, QEF_SET(1.f) };
+
+		QEF_FLOAT fnorm = QEFSquare(vtav.m00);
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m01));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m02));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m01));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m11));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m12));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m02));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m12));
+		fnorm = QEF_ADD(fnorm, QEFSquare(vtav.m22));
+		const QEF_FLOAT delta = QEF_MUL(QEF_SET(svdTol), QEF_SQRT(fnorm));
+
+		QEF_MASK active = QEF_GREATER_EQUAL(zero, zero);
+		for (int sweep = 0; sweep < sweeps; sweep++)
+		{
+			const QEF_FLOAT offSum = QEF_ADD(QEF_ADD(QEFSquare(vtav.m01), QEFSquare(vtav.m02)), QEFSquare(vtav.m12));
+			const QEF_FLOAT off = QEF_SQRT(QEF_MUL(QEF_SET(2.f), offSum));
+			active = QEF_MASK_AND(active, QEF_GREATER(off, delta));
+			if (!QEF_MASK_ANY(active))
+				break;
+
+			QEFRotate01(vtav, v, active);
+			QEFRotate02(vtav, v, active);
+			QEFRotate12(vtav, v, active);
+		}
+
+		//x = pinv(ata) * atb
+		const QEF_FLOAT tol = QEF_SET(pinvTol);
+		const QEF_FLOAT d[3] = { QEFPinv(vtav.m00, tol), QEFPinv(vtav.m11, tol), QEFPinv(vtav.m22, tol) };
+		QEF_FLOAT p[9];
+		for (int r = 0; r < 3; r++)
+			for (int k = 0; k < 3; k++)
+				p[r * 3 + k] = QEFPinvEntry(v, r, k, d);
+
+		const QEF_FLOAT x = QEFDot(p[0], p[1], p[2], bx, by, bz);
+		const QEF_FLOAT y = QEFDot(p[3], p[4], p[5], bx, by, bz);
+		const QEF_FLOAT z = QEFDot(p[6], p[7], p[8], bx, by, bz);
+
+		//residual |ata * x - atb|^2
+		const QEF_FLOAT rx = QEF_SUB(bx, QEFDot(ata.m00, ata.m01, ata.m02, x, y, z));
+		const QEF_FLOAT ry = QEF_SUB(by, QEFDot(ata.m01, ata.m11, ata.m12, x, y, z));
+		const QEF_FLOAT rz = QEF_SUB(bz, QEFDot(ata.m02, ata.m12, ata.m22, x, y, z));
+		const QEF_FLOAT error = QEF_ADD(QEF_ADD(QEF_MUL(rx, rx), QEF_MUL(ry, ry)), QEF_MUL(rz, rz));
+
+		//fall back to the mass point when the solve blew up
+		const QEF_MASK invalid = QEF_IS_NAN(error);
+		QEF_STORE(arrays.position[0] + i, QEF_BLEND(QEF_ADD(x, mx), mx, invalid));
+		QEF_STORE(arrays.position[1] + i, QEF_BLEND(QEF_ADD(y, my), my, invalid));
+		QEF_STORE(arrays.position[2] + i, QEF_BLEND(QEF_ADD(z, mz), mz, invalid));
+		QEF_STORE(arrays.error + i, error);
+	}
+}
@@ -0,0 +1,34 @@
+#include "VoxelPlugin.hpp"
+
+#ifdef FN_COMPILE_SSE2
+#include <emmintrin.h>
+
+#define QEF_FLOAT __m128
+#define QEF_MASK __m128
+#define QEF_WIDTH 4
+#define QEF_KERNEL_NAME SolveQEFBatchSSE2
+
+#define QEF_LOAD(p) _mm_loadu_ps(p)
+#define QEF_STORE(p, a) _mm_storeu_ps(p, a)
+#define QEF_SET(a) _mm_set1_ps(a)
+#define QEF_ADD(a, b) _mm_add_ps(a, b)
+#define QEF_SUB(a, b) _mm_sub_ps(a, b)
+#define QEF_MUL(a, b) _mm_mul_ps(a, b)
+#define QEF_DIV(a, b) _mm_div_ps(a, b)
+#define QEF_SQRT(a) _mm_sqrt_ps(a)
+#define QEF_ABS(a) _mm_andnot_ps(_mm_set1_ps(-0.f), a)
+
+#define QEF_LESS(a, b) _mm_cmplt_ps(a, b)
+#define QEF_GREATER(a, b) _mm_cmpgt_ps(a, b)
+#define QEF_GREATER_EQUAL(a, b) _mm_cmpge_ps(a, b)
+#define QEF_NOT_EQUAL(a, b) _mm_cmpneq_ps(a, b)
+#define QEF_IS_NAN(a) _mm_cmpunord_ps(a, a)
+
+#define QEF_MASK_AND(a, b) _mm_and_ps(a, b)
+#define QEF_MASK_OR(a, b) _mm_or_ps(a, b)
+#define QEF_MASK_ANY(m) (_mm_movemask_ps(m) != 0)
+//b where the mask is set, a elsewhere
+#define QEF_BLEND(a, b, m) _mm_or_ps(_mm_and_ps(m, b), _mm_andnot_ps(m, a))
+
+#include "qefBatch_internal.hpp"
+#endif
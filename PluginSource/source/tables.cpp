@@ -133,7 +133,7 @@ const int num_vertices[256] =
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0
 };
 
-const int edge_table[256][16] =
+constexpr int edge_table[256][16] =
 {
 	{ -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
 	{ 0, 4, 8, -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
@@ -393,3 +393,320 @@ const int edge_table[256][16] =
 	{ -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }
 };
 
+//vertex of a cell that owns each edge, -1 when the edge has no crossing. derived from edge_table
+constexpr int edge_vertex_table[256][12] =
+{
+	{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1 },
+	{ -1, 0, -1, -1, -1, 0, -1, -1, 0, -1, -1, -1 },
+	{ 0, 0, -1, -1, 0, 0, -1, -1, -1, -1, -1, -1 },
+	{ -1, -1, 0, -1, 0, -1, -1, -1, -1, 0, -1, -1 },
+	{ 0, -1, 0, -1, -1, -1, -1, -1, 0, 0, -1, -1 },
+	{ -1, 1, 0, -1, 0, 1, -1, -1, 1, 0, -1, -1 },
+	{ 0, 0, 0, -1, -1, 0, -1, -1, -1, 0, -1, -1 },
+	{ -1, -1, -1, 0, -1, 0, -1, -1, -1, 0, -1, -1 },
+	{ 1, -1, -1, 0, 1, 0, -1, -1, 1, 0, -1, -1 },
+	{ -1, 0, -1, 0, -1, -1, -1, -1, 0, 0, -1, -1 },
+	{ 0, 0, -1, 0, 0, -1, -1, -1, -1, 0, -1, -1 },
+	{ -1, -1, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1 },
+	{ 0, -1, 0, 0, -1, 0, -1, -1, 0, -1, -1, -1 },
+	{ -1, 0, 0, 0, 0, -1, -1, -1, 0, -1, -1, -1 },
+	{ 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 0, -1, -1, -1, -1, -1, 0, -1, -1, -1, 0, -1 },
+	{ -1, -1, -1, -1, 0, -1, 0, -1, 0, -1, 0, -1 },
+	{ 0, 1, -1, -1, -1, 1, 0, -1, 1, -1, 0, -1 },
+	{ -1, 0, -1, -1, 0, 0, 0, -1, -1, -1, 0, -1 },
+	{ 0, -1, 1, -1, 1, -1, 0, -1, -1, 1, 0, -1 },
+	{ -1, -1, 0, -1, -1, -1, 0, -1, 0, 0, 0, -1 },
+	{ 0, 2, 1, -1, 1, 2, 0, -1, 2, 1, 0, -1 },
+	{ -1, 0, 0, -1, -1, 0, 0, -1, -1, 0, 0, -1 },
+	{ 1, -1, -1, 0, -1, 0, 1, -1, -1, 0, 1, -1 },
+	{ -1, -1, -1, 0, 1, 0, 1, -1, 1, 0, 1, -1 },
+	{ 0, 1, -1, 1, -1, -1, 0, -1, 1, 1, 0, -1 },
+	{ -1, 0, -1, 0, 0, -1, 0, -1, -1, 0, 0, -1 },
+	{ 0, -1, 1, 1, 1, 1, 0, -1, -1, -1, 0, -1 },
+	{ -1, -1, 0, 0, -1, 0, 0, -1, 0, -1, 0, -1 },
+	{ 0, 1, 1, 1, 1, -1, 0, -1, 1, -1, 0, -1 },
+	{ -1, 0, 0, 0, -1, -1, 0, -1, -1, -1, 0, -1 },
+	{ -1, 0, -1, -1, -1, -1, -1, 0, -1, -1, 0, -1 },
+	{ 0, 1, -1, -1, 0, -1, -1, 1, 0, -1, 1, -1 },
+	{ -1, -1, -1, -1, -1, 0, -1, 0, 0, -1, 0, -1 },
+	{ 0, -1, -1, -1, 0, 0, -1, 0, -1, -1, 0, -1 },
+	{ -1, 0, 1, -1, 1, -1, -1, 0, -1, 1, 0, -1 },
+	{ 1, 0, 1, -1, -1, -1, -1, 0, 1, 1, 0, -1 },
+	{ -1, -1, 1, -1, 1, 0, -1, 0, 0, 1, 0, -1 },
+	{ 0, -1, 0, -1, -1, 0, -1, 0, -1, 0, 0, -1 },
+	{ -1, 1, -1, 0, -1, 0, -1, 1, -1, 0, 1, -1 },
+	{ 2, 1, -1, 0, 2, 0, -1, 1, 2, 0, 1, -1 },
+	{ -1, -1, -1, 0, -1, -1, -1, 0, 0, 0, 0, -1 },
+	{ 0, -1, -1, 0, 0, -1, -1, 0, -1, 0, 0, -1 },
+	{ -1, 0, 1, 1, 1, 1, -1, 0, -1, -1, 0, -1 },
+	{ 1, 0, 1, 1, -1, 1, -1, 0, 1, -1, 0, -1 },
+	{ -1, -1, 0, 0, 0, -1, -1, 0, 0, -1, 0, -1 },
+	{ 0, -1, 0, 0, -1, -1, -1, 0, -1, -1, 0, -1 },
+	{ 0, 0, -1, -1, -1, -1, 0, 0, -1, -1, -1, -1 },
+	{ -1, 0, -1, -1, 0, -1, 0, 0, 0, -1, -1, -1 },
+	{ 0, -1, -1, -1, -1, 0, 0, 0, 0, -1, -1, -1 },
+	{ -1, -1, -1, -1, 0, 0, 0, 0, -1, -1, -1, -1 },
+	{ 0, 0, 1, -1, 1, -1, 0, 0, -1, 1, -1, -1 },
+	{ -1, 0, 0, -1, -1, -1, 0, 0, 0, 0, -1, -1 },
+	{ 1, -1, 0, -1, 0, 1, 1, 1, 1, 0, -1, -1 },
+	{ -1, -1, 0, -1, -1, 0, 0, 0, -1, 0, -1, -1 },
+	{ 1, 1, -1, 0, -1, 0, 1, 1, -1, 0, -1, -1 },
+	{ -1, 1, -1, 0, 1, 0, 1, 1, 1, 0, -1, -1 },
+	{ 0, -1, -1, 0, -1, -1, 0, 0, 0, 0, -1, -1 },
+	{ -1, -1, -1, 0, 0, -1, 0, 0, -1, 0, -1, -1 },
+	{ 0, 0, 1, 1, 1, 1, 0, 0, -1, -1, -1, -1 },
+	{ -1, 0, 0, 0, -1, 0, 0, 0, 0, -1, -1, -1 },
+	{ 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, -1, -1 },
+	{ -1, -1, 0, 0, -1, -1, 0, 0, -1, -1, -1, -1 },
+	{ -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, -1, 0 },
+	{ 1, -1, 0, -1, 1, -1, 0, -1, 1, -1, -1, 0 },
+	{ -1, 1, 0, -1, -1, 1, 0, -1, 1, -1, -1, 0 },
+	{ 1, 1, 0, -1, 1, 1, 0, -1, -1, -1, -1, 0 },
+	{ -1, -1, -1, -1, 0, -1, 0, -1, -1, 0, -1, 0 },
+	{ 0, -1, -1, -1, -1, -1, 0, -1, 0, 0, -1, 0 },
+	{ -1, 0, -1, -1, 1, 0, 1, -1, 0, 1, -1, 1 },
+	{ 0, 0, -1, -1, -1, 0, 0, -1, -1, 0, -1, 0 },
+	{ -1, -1, 1, 0, -1, 0, 1, -1, -1, 0, -1, 1 },
+	{ 2, -1, 1, 0, 2, 0, 1, -1, 2, 0, -1, 1 },
+	{ -1, 1, 0, 1, -1, -1, 0, -1, 1, 1, -1, 0 },
+	{ 1, 1, 0, 1, 1, -1, 0, -1, -1, 1, -1, 0 },
+	{ -1, -1, -1, 0, 0, 0, 0, -1, -1, -1, -1, 0 },
+	{ 0, -1, -1, 0, -1, 0, 0, -1, 0, -1, -1, 0 },
+	{ -1, 0, -1, 0, 0, -1, 0, -1, 0, -1, -1, 0 },
+	{ 0, 0, -1, 0, -1, -1, 0, -1, -1, -1, -1, 0 },
+	{ 0, -1, 0, -1, -1, -1, -1, -1, -1, -1, 0, 0 },
+	{ -1, -1, 0, -1, 0, -1, -1, -1, 0, -1, 0, 0 },
+	{ 1, 0, 1, -1, -1, 0, -1, -1, 0, -1, 1, 1 },
+	{ -1, 0, 0, -1, 0, 0, -1, -1, -1, -1, 0, 0 },
+	{ 0, -1, -1, -1, 0, -1, -1, -1, -1, 0, 0, 0 },
+	{ -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0 },
+	{ 1, 0, -1, -1, 1, 0, -1, -1, 0, 1, 1, 1 },
+	{ -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, 0, 0 },
+	{ 1, -1, 1, 0, -1, 0, -1, -1, -1, 0, 1, 1 },
+	{ -1, -1, 1, 0, 1, 0, -1, -1, 1, 0, 1, 1 },
+	{ 1, 0, 1, 0, -1, -1, -1, -1, 0, 0, 1, 1 },
+	{ -1, 0, 0, 0, 0, -1, -1, -1, -1, 0, 0, 0 },
+	{ 0, -1, -1, 0, 0, 0, -1, -1, -1, -1, 0, 0 },
+	{ -1, -1, -1, 0, -1, 0, -1, -1, 0, -1, 0, 0 },
+	{ 0, 0, -1, 0, 0, -1, -1, -1, 0, -1, 0, 0 },
+	{ -1, 0, -1, 0, -1, -1, -1, -1, -1, -1, 0, 0 },
+	{ -1, 0, 1, -1, -1, -1, 1, 0, -1, -1, 0, 1 },
+	{ 0, 1, 2, -1, 0, -1, 2, 1, 0, -1, 1, 2 },
+	{ -1, -1, 1, -1, -1, 0, 1, 0, 0, -1, 0, 1 },
+	{ 1, -1, 0, -1, 1, 1, 0, 1, -1, -1, 1, 0 },
+	{ -1, 0, -1, -1, 1, -1, 1, 0, -1, 1, 0, 1 },
+	{ 1, 0, -1, -1, -1, -1, 1, 0, 1, 1, 0, 1 },
+	{ -1, -1, -1, -1, 1, 0, 1, 0, 0, 1, 0, 1 },
+	{ 0, -1, -1, -1, -1, 0, 0, 0, -1, 0, 0, 0 },
+	{ -1, 2, 1, 0, -1, 0, 1, 2, -1, 0, 2, 1 },
+	{ 3, 2, 1, 0, 3, 0, 1, 2, 3, 0, 2, 1 },
+	{ -1, -1, 0, 1, -1, -1, 0, 1, 1, 1, 1, 0 },
+	{ 1, -1, 0, 1, 1, -1, 0, 1, -1, 1, 1, 0 },
+	{ -1, 0, -1, 1, 1, 1, 1, 0, -1, -1, 0, 1 },
+	{ 1, 0, -1, 1, -1, 1, 1, 0, 1, -1, 0, 1 },
+	{ -1, -1, -1, 0, 0, -1, 0, 0, 0, -1, 0, 0 },
+	{ 0, -1, -1, 0, -1, -1, 0, 0, -1, -1, 0, 0 },
+	{ 0, 0, 0, -1, -1, -1, -1, 0, -1, -1, -1, 0 },
+	{ -1, 0, 0, -1, 0, -1, -1, 0, 0, -1, -1, 0 },
+	{ 0, -1, 0, -1, -1, 0, -1, 0, 0, -1, -1, 0 },
+	{ -1, -1, 0, -1, 0, 0, -1, 0, -1, -1, -1, 0 },
+	{ 0, 0, -1, -1, 0, -1, -1, 0, -1, 0, -1, 0 },
+	{ -1, 0, -1, -1, -1, -1, -1, 0, 0, 0, -1, 0 },
+	{ 0, -1, -1, -1, 0, 0, -1, 0, 0, 0, -1, 0 },
+	{ -1, -1, -1, -1, -1, 0, -1, 0, -1, 0, -1, 0 },
+	{ 1, 1, 1, 0, -1, 0, -1, 1, -1, 0, -1, 1 },
+	{ -1, 1, 1, 0, 1, 0, -1, 1, 1, 0, -1, 1 },
+	{ 0, -1, 0, 0, -1, -1, -1, 0, 0, 0, -1, 0 },
+	{ -1, -1, 0, 0, 0, -1, -1, 0, -1, 0, -1, 0 },
+	{ 0, 0, -1, 0, 0, 0, -1, 0, -1, -1, -1, 0 },
+	{ -1, 0, -1, 0, -1, 0, -1, 0, 0, -1, -1, 0 },
+	{ 0, -1, -1, 0, 0, -1, -1, 0, 0, -1, -1, 0 },
+	{ -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0 },
+	{ -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0 },
+	{ 0, -1, -1, 1, 0, -1, -1, 1, 0, -1, -1, 1 },
+	{ -1, 0, -1, 1, -1, 0, -1, 1, 0, -1, -1, 1 },
+	{ 1, 1, -1, 0, 1, 1, -1, 0, -1, -1, -1, 0 },
+	{ -1, -1, 0, 1, 0, -1, -1, 1, -1, 0, -1, 1 },
+	{ 1, -1, 1, 0, -1, -1, -1, 0, 1, 1, -1, 0 },
+	{ -1, 0, 2, 1, 2, 0, -1, 1, 0, 2, -1, 1 },
+	{ 1, 1, 1, 0, -1, 1, -1, 0, -1, 1, -1, 0 },
+	{ -1, -1, -1, -1, -1, 0, -1, 0, -1, 0, -1, 0 },
+	{ 1, -1, -1, -1, 1, 0, -1, 0, 1, 0, -1, 0 },
+	{ -1, 0, -1, -1, -1, -1, -1, 0, 0, 0, -1, 0 },
+	{ 0, 0, -1, -1, 0, -1, -1, 0, -1, 0, -1, 0 },
+	{ -1, -1, 0, -1, 0, 0, -1, 0, -1, -1, -1, 0 },
+	{ 0, -1, 0, -1, -1, 0, -1, 0, 0, -1, -1, 0 },
+	{ -1, 0, 0, -1, 0, -1, -1, 0, 0, -1, -1, 0 },
+	{ 0, 0, 0, -1, -1, -1, -1, 0, -1, -1, -1, 0 },
+	{ 0, -1, -1, 1, -1, -1, 0, 1, -1, -1, 0, 1 },
+	{ -1, -1, -1, 0, 1, -1, 1, 0, 1, -1, 1, 0 },
+	{ 1, 0, -1, 2, -1, 0, 1, 2, 0, -1, 1, 2 },
+	{ -1, 1, -1, 0, 1, 1, 1, 0, -1, -1, 1, 0 },
+	{ 1, -1, 2, 0, 2, -1, 1, 0, -1, 2, 1, 0 },
+	{ -1, -1, 1, 0, -1, -1, 1, 0, 1, 1, 1, 0 },
+	{ 1, 0, 3, 2, 3, 0, 1, 2, 0, 3, 1, 2 },
+	{ -1, 1, 1, 0, -1, 1, 1, 0, -1, 1, 1, 0 },
+	{ 1, -1, -1, -1, -1, 0, 1, 0, -1, 0, 1, 0 },
+	{ -1, -1, -1, -1, 1, 0, 1, 0, 1, 0, 1, 0 },
+	{ 0, 1, -1, -1, -1, -1, 0, 1, 1, 1, 0, 1 },
+	{ -1, 0, -1, -1, 0, -1, 0, 0, -1, 0, 0, 0 },
+	{ 0, -1, 1, -1, 1, 1, 0, 1, -1, -1, 0, 1 },
+	{ -1, -1, 0, -1, -1, 0, 0, 0, 0, -1, 0, 0 },
+	{ 0, 1, 1, -1, 1, -1, 0, 1, 1, -1, 0, 1 },
+	{ -1, 0, 0, -1, -1, -1, 0, 0, -1, -1, 0, 0 },
+	{ -1, 0, -1, 0, -1, -1, -1, -1, -1, -1, 0, 0 },
+	{ 0, 1, -1, 1, 0, -1, -1, -1, 0, -1, 1, 1 },
+	{ -1, -1, -1, 0, -1, 0, -1, -1, 0, -1, 0, 0 },
+	{ 0, -1, -1, 0, 0, 0, -1, -1, -1, -1, 0, 0 },
+	{ -1, 1, 0, 1, 0, -1, -1, -1, -1, 0, 1, 1 },
+	{ 0, 1, 0, 1, -1, -1, -1, -1, 0, 0, 1, 1 },
+	{ -1, -1, 0, 1, 0, 1, -1, -1, 1, 0, 1, 1 },
+	{ 0, -1, 0, 0, -1, 0, -1, -1, -1, 0, 0, 0 },
+	{ -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, 0, 0 },
+	{ 1, 0, -1, -1, 1, 0, -1, -1, 1, 0, 0, 0 },
+	{ -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0 },
+	{ 0, -1, -1, -1, 0, -1, -1, -1, -1, 0, 0, 0 },
+	{ -1, 0, 0, -1, 0, 0, -1, -1, -1, -1, 0, 0 },
+	{ 0, 0, 0, -1, -1, 0, -1, -1, 0, -1, 0, 0 },
+	{ -1, -1, 0, -1, 0, -1, -1, -1, 0, -1, 0, 0 },
+	{ 0, -1, 0, -1, -1, -1, -1, -1, -1, -1, 0, 0 },
+	{ 0, 0, -1, 0, -1, -1, 0, -1, -1, -1, -1, 0 },
+	{ -1, 0, -1, 0, 0, -1, 0, -1, 0, -1, -1, 0 },
+	{ 0, -1, -1, 0, -1, 0, 0, -1, 0, -1, -1, 0 },
+	{ -1, -1, -1, 0, 0, 0, 0, -1, -1, -1, -1, 0 },
+	{ 1, 1, 0, 1, 0, -1, 1, -1, -1, 0, -1, 1 },
+	{ -1, 0, 0, 0, -1, -1, 0, -1, 0, 0, -1, 0 },
+	{ 1, -1, 0, 1, 0, 1, 1, -1, 1, 0, -1, 1 },
+	{ -1, -1, 0, 0, -1, 0, 0, -1, -1, 0, -1, 0 },
+	{ 0, 0, -1, -1, -1, 0, 0, -1, -1, 0, -1, 0 },
+	{ -1, 0, -1, -1, 0, 0, 0, -1, 0, 0, -1, 0 },
+	{ 0, -1, -1, -1, -1, -1, 0, -1, 0, 0, -1, 0 },
+	{ -1, -1, -1, -1, 0, -1, 0, -1, -1, 0, -1, 0 },
+	{ 0, 0, 0, -1, 0, 0, 0, -1, -1, -1, -1, 0 },
+	{ -1, 0, 0, -1, -1, 0, 0, -1, 0, -1, -1, 0 },
+	{ 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, -1, 0 },
+	{ -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, -1, 0 },
+	{ -1, -1, 0, 0, -1, -1, 0, 0, -1, -1, -1, -1 },
+	{ 0, -1, 1, 1, 0, -1, 1, 1, 0, -1, -1, -1 },
+	{ -1, 0, 1, 1, -1, 0, 1, 1, 0, -1, -1, -1 },
+	{ 0, 0, 1, 1, 0, 0, 1, 1, -1, -1, -1, -1 },
+	{ -1, -1, -1, 0, 0, -1, 0, 0, -1, 0, -1, -1 },
+	{ 0, -1, -1, 0, -1, -1, 0, 0, 0, 0, -1, -1 },
+	{ -1, 0, -1, 1, 1, 0, 1, 1, 0, 1, -1, -1 },
+	{ 0, 0, -1, 0, -1, 0, 0, 0, -1, 0, -1, -1 },
+	{ -1, -1, 0, -1, -1, 0, 0, 0, -1, 0, -1, -1 },
+	{ 0, -1, 1, -1, 0, 1, 1, 1, 0, 1, -1, -1 },
+	{ -1, 0, 0, -1, -1, -1, 0, 0, 0, 0, -1, -1 },
+	{ 0, 0, 0, -1, 0, -1, 0, 0, -1, 0, -1, -1 },
+	{ -1, -1, -1, -1, 0, 0, 0, 0, -1, -1, -1, -1 },
+	{ 0, -1, -1, -1, -1, 0, 0, 0, 0, -1, -1, -1 },
+	{ -1, 0, -1, -1, 0, -1, 0, 0, 0, -1, -1, -1 },
+	{ 0, 0, -1, -1, -1, -1, 0, 0, -1, -1, -1, -1 },
+	{ 0, -1, 0, 0, -1, -1, -1, 0, -1, -1, 0, -1 },
+	{ -1, -1, 0, 0, 0, -1, -1, 0, 0, -1, 0, -1 },
+	{ 1, 0, 1, 1, -1, 0, -1, 1, 0, -1, 1, -1 },
+	{ -1, 0, 0, 0, 0, 0, -1, 0, -1, -1, 0, -1 },
+	{ 0, -1, -1, 0, 0, -1, -1, 0, -1, 0, 0, -1 },
+	{ -1, -1, -1, 0, -1, -1, -1, 0, 0, 0, 0, -1 },
+	{ 1, 0, -1, 1, 1, 0, -1, 1, 0, 1, 1, -1 },
+	{ -1, 0, -1, 0, -1, 0, -1, 0, -1, 0, 0, -1 },
+	{ 0, -1, 0, -1, -1, 0, -1, 0, -1, 0, 0, -1 },
+	{ -1, -1, 0, -1, 0, 0, -1, 0, 0, 0, 0, -1 },
+	{ 0, 0, 0, -1, -1, -1, -1, 0, 0, 0, 0, -1 },
+	{ -1, 0, 0, -1, 0, -1, -1, 0, -1, 0, 0, -1 },
+	{ 0, -1, -1, -1, 0, 0, -1, 0, -1, -1, 0, -1 },
+	{ -1, -1, -1, -1, -1, 0, -1, 0, 0, -1, 0, -1 },
+	{ 0, 0, -1, -1, 0, -1, -1, 0, 0, -1, 0, -1 },
+	{ -1, 0, -1, -1, -1, -1, -1, 0, -1, -1, 0, -1 },
+	{ -1, 0, 0, 0, -1, -1, 0, -1, -1, -1, 0, -1 },
+	{ 0, 1, 1, 1, 0, -1, 1, -1, 0, -1, 1, -1 },
+	{ -1, -1, 0, 0, -1, 0, 0, -1, 0, -1, 0, -1 },
+	{ 0, -1, 0, 0, 0, 0, 0, -1, -1, -1, 0, -1 },
+	{ -1, 0, -1, 0, 0, -1, 0, -1, -1, 0, 0, -1 },
+	{ 0, 0, -1, 0, -1, -1, 0, -1, 0, 0, 0, -1 },
+	{ -1, -1, -1, 0, 0, 0, 0, -1, 0, 0, 0, -1 },
+	{ 0, -1, -1, 0, -1, 0, 0, -1, -1, 0, 0, -1 },
+	{ -1, 0, 0, -1, -1, 0, 0, -1, -1, 0, 0, -1 },
+	{ 1, 0, 0, -1, 1, 0, 0, -1, 1, 0, 0, -1 },
+	{ -1, -1, 0, -1, -1, -1, 0, -1, 0, 0, 0, -1 },
+	{ 0, -1, 0, -1, 0, -1, 0, -1, -1, 0, 0, -1 },
+	{ -1, 0, -1, -1, 0, 0, 0, -1, -1, -1, 0, -1 },
+	{ 0, 0, -1, -1, -1, 0, 0, -1, 0, -1, 0, -1 },
+	{ -1, -1, -1, -1, 0, -1, 0, -1, 0, -1, 0, -1 },
+	{ 0, -1, -1, -1, -1, -1, 0, -1, -1, -1, 0, -1 },
+	{ 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ -1, 0, 0, 0, 0, -1, -1, -1, 0, -1, -1, -1 },
+	{ 0, -1, 0, 0, -1, 0, -1, -1, 0, -1, -1, -1 },
+	{ -1, -1, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1 },
+	{ 0, 0, -1, 0, 0, -1, -1, -1, -1, 0, -1, -1 },
+	{ -1, 0, -1, 0, -1, -1, -1, -1, 0, 0, -1, -1 },
+	{ 0, -1, -1, 0, 0, 0, -1, -1, 0, 0, -1, -1 },
+	{ -1, -1, -1, 0, -1, 0, -1, -1, -1, 0, -1, -1 },
+	{ 0, 0, 0, -1, -1, 0, -1, -1, -1, 0, -1, -1 },
+	{ -1, 0, 0, -1, 0, 0, -1, -1, 0, 0, -1, -1 },
+	{ 0, -1, 0, -1, -1, -1, -1, -1, 0, 0, -1, -1 },
+	{ -1, -1, 0, -1, 0, -1, -1, -1, -1, 0, -1, -1 },
+	{ 0, 0, -1, -1, 0, 0, -1, -1, -1, -1, -1, -1 },
+	{ -1, 0, -1, -1, -1, 0, -1, -1, 0, -1, -1, -1 },
+	{ 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1 },
+	{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }
+};
+
+//number of vertices edge_table places in each corner configuration
+constexpr int vertex_count_table[256] =
+{
+	0, 1, 1, 1, 1, 1, 2, 1, 1, 2, 1, 1, 1, 1, 1, 1,
+	1, 1, 2, 1, 2, 1, 3, 1, 2, 2, 2, 1, 2, 1, 2, 1,
+	1, 2, 1, 1, 2, 2, 2, 1, 2, 3, 1, 1, 2, 2, 1, 1,
+	1, 1, 1, 1, 2, 1, 2, 1, 2, 2, 1, 1, 2, 1, 1, 1,
+	1, 2, 2, 2, 1, 1, 2, 1, 2, 3, 2, 2, 1, 1, 1, 1,
+	1, 1, 2, 1, 1, 1, 2, 1, 2, 2, 2, 1, 1, 1, 1, 1,
+	2, 3, 2, 2, 2, 2, 2, 1, 3, 4, 2, 2, 2, 2, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1, 1, 1, 1, 1,
+	1, 2, 2, 2, 2, 2, 3, 2, 1, 2, 1, 1, 1, 1, 1, 1,
+	2, 2, 3, 2, 3, 2, 4, 2, 2, 2, 2, 1, 2, 1, 2, 1,
+	1, 2, 1, 1, 2, 2, 2, 1, 1, 2, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 2, 2, 2, 1, 1, 2, 1, 1, 2, 1, 1, 1, 1, 1, 1,
+	1, 1, 2, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0
+};
+
+//edge_table lists the edges of each vertex, the vertices separated by -1 and the list ended by -2.
+//the two tables above are typed out so they stay plain arrays, these check them against it.
+//checked in quarters to stay well inside the compilers' constexpr evaluation limits
+static constexpr bool CheckEdgeVertexTables(int begin, int end)
+{
+	for (int corners = begin; corners < end; corners++)
+	{
+		int owner[12] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+		int vertex = 0;
+		int i = 0;
+		for (; edge_table[corners][i] != -2; i++)
+		{
+			if (edge_table[corners][i] == -1)
+				vertex++;
+			else
+				owner[edge_table[corners][i]] = vertex;
+		}
+
+		if (vertex_count_table[corners] != (i > 0 ? vertex + 1 : 0))
+			return false;
+		for (int edge = 0; edge < 12; edge++)
+		{
+			if (edge_vertex_table[corners][edge] != owner[edge])
+				return false;
+		}
+	}
+	return true;
+}
+
+static_assert(CheckEdgeVertexTables(0, 64), "edge_vertex_table or vertex_count_table does not match edge_table");
+static_assert(CheckEdgeVertexTables(64, 128), "edge_vertex_table or vertex_count_table does not match edge_table");
+static_assert(CheckEdgeVertexTables(128, 192), "edge_vertex_table or vertex_count_table does not match edge_table");
+static_assert(CheckEdgeVertexTables(192, 256), "edge_vertex_table or vertex_count_table does not match edge_table");
+
+
@@ -3,6 +3,8 @@ extern const int edgevmap[12][2];
 
 extern const int num_vertices[256];
 extern const int edge_table[256][16];
+extern const int edge_vertex_table[256][12];
+extern const int vertex_count_table[256];
 
 extern const int corner_deltas[8];
 extern const glm::vec3 corner_deltas_f[8];
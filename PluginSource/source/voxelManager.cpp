@@ -7,36 +7,57 @@
 using namespace enki;
 static enki::TaskScheduler g_TScheduler;
 
-//generate chunks of volume chunkRange^3
-struct GenerateChunkTaskSet : ITaskSet
+static vector<Chunk*> g_generatedChunks; //finished by the workers, waiting for neighbours and seams
+static std::mutex g_generatedLock;
+
+//generates queued chunks one by one, every iteration takes the nearest chunk still queued
+struct GenerateChunkTaskSet final : ITaskSet
 {
-	Chunk *chunks;
+	ChunkQueue *queue;
+	ChunkPool *pool;
 	float voxelSize;
 	glm::vec3 chunkSize;
-	vector<glm::ivec3> chunkIndices;
-	int chunkRange;
 
-	GenerateChunkTaskSet(const uint32_t size_, Chunk *chunks, const vector<glm::ivec3> &chunkIndices, const float voxelSize, const glm::vec3 &chunkSize)
+	GenerateChunkTaskSet(const uint32_t size_, ChunkQueue *queue, ChunkPool *pool, const float voxelSize, const glm::vec3 &chunkSize)
 	{
 		m_SetSize = size_;
-		this->chunks = chunks;
+		this->queue = queue;
+		this->pool = pool;
 		this->voxelSize = voxelSize;
 		this->chunkSize = chunkSize;
-		this->chunkIndices = chunkIndices;
 	}
 
 	void ExecuteRange(TaskSetPartition range, uint32_t threadnum)
 	{
-		for (int i = range.start; i < range.end; i++)
+		for (uint32_t i = range.start; i < range.end; i++)
 		{
-			Density::DensityType type = chunkIndices[i].y < 0 ? Density::Cave : Density::Terrain;
+			//the lod ring follows the player at the time the chunk is started
+			glm::ivec3 chunkIndex, playerChunkIndex;
+			if (!queue->Pop(chunkIndex, playerChunkIndex))
+				return;
+
+			Density::DensityType type = chunkIndex.y < 0 ? Density::Cave : Density::Terrain;
 			//Density::DensityType type = Density::Terrain;
-			chunks[i].Init(chunkIndices[i], chunkSize, type, voxelSize);
+			glm::ivec3 offset = glm::abs(chunkIndex - playerChunkIndex);
+			int distance = glm::max(offset.x, glm::max(offset.y, offset.z));
+
+			//same world footprint at every ring, half the cells of twice the size per ring out
+			int lod = Chunk::GetLodLevel(distance, chunkSize.x);
+			int lodVoxelSize = (int)voxelSize << lod;
+			Chunk *chunk = pool->Acquire();
+			ChunkBuildData *buildData = pool->AcquireBuildData();
+			chunk->SwapBuildData(*buildData);
+			chunk->Init(chunkIndex, chunkSize / (float)(1 << lod), type, lodVoxelSize, Chunk::GetLodError(distance, lodVoxelSize), lod);
+			chunk->SwapBuildData(*buildData);
+			pool->ReleaseBuildData(buildData);
+
+			std::lock_guard<std::mutex> lock(g_generatedLock);
+			g_generatedChunks.push_back(chunk);
 		}
 	}
 };
 
-struct GenerateSeamTask : ITaskSet
+struct GenerateSeamTask final : ITaskSet
 {
 	std::vector<Chunk *> chunks;
 
@@ -48,35 +69,91 @@ struct GenerateSeamTask : ITaskSet
 
 	void ExecuteRange(TaskSetPartition range, uint32_t threadnum)
 	{
-		for (int i = range.start; i < range.end; i++)
+		for (uint32_t i = range.start; i < range.end; i++)
 			chunks[i]->GenerateSeam();
 	}
 };
 
-static vector<GenerateChunkTaskSet> g_genChunkTasks;
-static vector<GenerateSeamTask> g_genSeamTasks;
+//the scheduler keeps pointers to queued tasks, so they must not move while in flight
+static GenerateChunkTaskSet *g_genChunkTask = nullptr;
+static vector<GenerateSeamTask*> g_genSeamTasks;
 
 static vector<Chunk*> g_newChunks;
 static vector<int> g_newChunkVertCount;
 static vector<int> g_newChunkTriCount;
+static vector<int> g_newChunkSeamTriCount;
+static vector<ChunkMeshStats> g_newChunkStats;
 
-VoxelManager::VoxelManager()
+static vector<glm::ivec3> g_retiredChunks;
+
+//chunks taken out of the grid. A bind running on the render thread may still hold them, so
+//they are only unloaded and pooled once a BindChunks that started after them has finished
+static vector<Chunk*> g_releasedChunks;
+static std::mutex g_releasedLock;
+
+//forgets chunks waiting to be bound together with their counts
+static void DropNewChunks(const std::unordered_set<Chunk*> &dropped)
 {
+	int kept = 0;
+	for (size_t i = 0; i < g_newChunks.size(); i++)
+	{
+		if (dropped.count(g_newChunks[i]))
+			continue;
 
+		g_newChunks[kept] = g_newChunks[i];
+		g_newChunkVertCount[kept] = g_newChunkVertCount[i];
+		g_newChunkTriCount[kept] = g_newChunkTriCount[i];
+		g_newChunkSeamTriCount[kept] = g_newChunkSeamTriCount[i];
+		g_newChunkStats[kept] = g_newChunkStats[i];
+		kept++;
+	}
+	g_newChunks.resize(kept);
+	g_newChunkVertCount.resize(kept);
+	g_newChunkTriCount.resize(kept);
+	g_newChunkSeamTriCount.resize(kept);
+	g_newChunkStats.resize(kept);
 }
 
-VoxelManager::~VoxelManager()
+VoxelManager::VoxelManager() : m_memoryBudget(VOXEL_MEMORY_BUDGET)
 {
-	LogToUnity("Deleting Chunks");
-	for (auto chunk : m_chunks)
-		delete chunk;
 
-	m_chunkMap.empty();
+}
+
+VoxelManager::~VoxelManager()
+{
 	g_newChunks.clear();
 	g_newChunkTriCount.clear();
 	g_newChunkVertCount.clear();
-	g_genChunkTasks.clear();
+	g_newChunkSeamTriCount.clear();
+	g_newChunkStats.clear();
+	g_retiredChunks.clear();
+	m_chunkQueue.Clear();
+	g_TScheduler.WaitforAll();
+	delete g_genChunkTask;
+	g_genChunkTask = nullptr;
+	for (auto task : g_genSeamTasks)
+		delete task;
 	g_genSeamTasks.clear();
+
+	//buffers belong to unity, unloading forgets them before the chunks are deleted
+	LogToUnity("Deleting Chunks");
+	m_chunkGrid.ForEach([](ChunkSlot &slot)
+	{
+		if (!slot.chunk) return;
+		slot.chunk->Unload();
+		delete slot.chunk;
+	});
+	m_chunkGrid.Clear();
+	for (Chunk *chunk : g_generatedChunks)
+		delete chunk;
+	g_generatedChunks.clear();
+	for (Chunk *chunk : g_releasedChunks)
+	{
+		chunk->Unload();
+		delete chunk;
+	}
+	g_releasedChunks.clear();
+	m_chunkPool.Clear();
 	g_TScheduler.~TaskScheduler();
 }
 
@@ -87,19 +164,24 @@ void VoxelManager::Init(int voxelSize, int range, float startRange, int chunkSiz
 	m_renderRange = range;
 	m_chunkSize = chunkSize;
 	m_activeChunks = 0;
+	m_playerChunkIndex = glm::ivec3(0);
+	m_viewDirection = glm::vec3(0.f);
+	m_retirePending = false;
+	m_chunkQueue.SetFocus(m_playerChunkIndex, m_viewDirection);
 	int x_range = 2 * m_renderRange + 1;
 	int z_range = x_range;
 	int y_range = 3;
 	m_totalChunks = x_range * y_range * z_range;
 
-	m_chunkMap.reserve(m_totalChunks);
-	m_chunks.reserve(m_totalChunks);
-	Chunk * chunks = new Chunk[m_totalChunks];
-	for (int i = 0; i < m_totalChunks; i++)
-		m_chunks[i] = &chunks[i];
+	//every chunk not yet evictable lives in the grid, the rest in its overflow
+	m_chunkGrid.Init(m_renderRange + VOXEL_STREAM_HYSTERESIS, m_playerChunkIndex);
+
+	//one step of the player streams in a slice of the render volume
+	m_chunkPool.SetCapacity(2 * x_range * z_range);
 
 	Density::SetVoxelSize(m_voxelSize);
 	Density::SetMaxVoxelHeight(maxHeight);
+	Density::SetChunkSize(m_chunkSize);
 	Density::Initialize();
 
 	g_TScheduler.Initialize();
@@ -139,7 +221,8 @@ void VoxelManager::Init(int voxelSize, int range, float startRange, int chunkSiz
 			for (int y = -m_renderRange; y <= m_renderRange; y++)
 			{
 				glm::vec3 index(x, y, z);
-				if (!m_chunkInitMap[index])
+				ChunkSlot *slot = m_chunkGrid.Find(index);
+				if (!slot || !slot->queued)
 				{
 					renderIndices.push_back(index);
 					count++;
@@ -151,18 +234,23 @@ void VoxelManager::Init(int voxelSize, int range, float startRange, int chunkSiz
 	GenerateChunksInRange(count, &renderIndices[0]);
 }
 
+Chunk *VoxelManager::FindChunk(const glm::ivec3 &index)
+{
+	return m_chunkGrid.FindChunk(index);
+}
+
 void VoxelManager::AssignChunkNeighbors(Chunk *chunk)
 {
 	if (!chunk) return;
 	const glm::ivec3 chunkIndex = chunk->m_chunkIndex;
 
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(0, 1, 0)], TOP);
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(0, -1, 0)], BOTTOM);
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(-1, 0, 0)], LEFT);
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(1, 0, 0)], RIGHT);
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(0, 0, -1)], BACK);
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(0, 0, 1)], FRONT);
-	chunk->AssignNeighbor(m_chunkMap[chunkIndex + glm::ivec3(1, 0, 1)], FRONT_RIGHT);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(0, 1, 0)), TOP);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(0, -1, 0)), BOTTOM);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(-1, 0, 0)), LEFT);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(1, 0, 0)), RIGHT);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(0, 0, -1)), BACK);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(0, 0, 1)), FRONT);
+	chunk->AssignNeighbor(FindChunk(chunkIndex + glm::ivec3(1, 0, 1)), FRONT_RIGHT);
 }
 
 void VoxelManager::GenerateChunksInRange(int count, glm::vec3 *indices)
@@ -173,35 +261,50 @@ void VoxelManager::GenerateChunksInRange(int count, glm::vec3 *indices)
 		return;
 	}
 
-	vector<glm::ivec3> taskIndices(count);	
-	int taskSize = 0;	
 	for (int i = 0; i < count; i++)
 	{
 		glm::ivec3 chunkWorldIndices = glm::ivec3(indices[i]);
-		if (m_chunkInitMap[chunkWorldIndices] == false)
+		ChunkSlot &slot = m_chunkGrid.Insert(chunkWorldIndices);
+		if (!slot.queued)
 		{			
-			taskIndices[i] = chunkWorldIndices;
-			m_chunkInitMap[chunkWorldIndices] = true;
-			taskSize++;
+			slot.queued = true;
+			m_chunkQueue.Push(chunkWorldIndices);
 		}
 	}
-	Chunk *chunks = new Chunk[taskSize];
-	for (int i = 0; i < taskSize; i++)	
-		m_chunkMap[taskIndices[i]] = &chunks[i];
-
-	if (taskSize == 0) return;
-	
-	GenerateChunkTaskSet genTask(taskSize, chunks, taskIndices, m_voxelSize, glm::vec3(m_chunkSize));
-	g_genChunkTasks.push_back(genTask);
-	g_TScheduler.AddTaskSetToPipe(&g_genChunkTasks[g_genChunkTasks.size() - 1]);
+
+	DispatchChunkJobs();
+}
+
+void VoxelManager::DispatchChunkJobs()
+{
+	if (g_genChunkTask)
+	{
+		//the running task keeps popping until the queue is empty or its iterations run out
+		if (!g_genChunkTask->GetIsComplete())
+			return;
+
+		delete g_genChunkTask;
+		g_genChunkTask = nullptr;
+	}
+
+	int queued = m_chunkQueue.GetCount();
+	if (queued == 0) return;
+
+	g_genChunkTask = new GenerateChunkTaskSet(queued, &m_chunkQueue, &m_chunkPool, m_voxelSize, glm::vec3(m_chunkSize));
+	g_TScheduler.AddTaskSetToPipe(g_genChunkTask);
 }
 
 void VoxelManager::GenerateSeamJob(int size, vector<Chunk *> chunks)
 {
-	GenerateSeamTask newTask(size, chunks);
+	GenerateSeamTask *newTask = new GenerateSeamTask(size, chunks);
 	g_genSeamTasks.push_back(newTask);
 
-	g_TScheduler.AddTaskSetToPipe(&g_genSeamTasks[g_genSeamTasks.size() - 1]);
+	g_TScheduler.AddTaskSetToPipe(newTask);
+}
+
+enki::TaskScheduler *VoxelManager::GetTaskScheduler()
+{
+	return g_TScheduler.GetNumTaskThreads() > 1 ? &g_TScheduler : nullptr;
 }
 
 int VoxelManager::GetChunkCount()
@@ -223,6 +326,18 @@ void VoxelManager::GetNewChunkTriangles(const int count, int *triArr)
 	}
 }
 
+void VoxelManager::GetNewChunkSeamTriangles(const int count, int *triArr)
+{
+	for (size_t i = 0; i < g_newChunkSeamTriCount.size() && i < (size_t)count; i++)
+		triArr[i] = g_newChunkSeamTriCount[i];
+}
+
+void VoxelManager::GetNewChunkStats(const int count, ChunkMeshStats *stats)
+{
+	for (size_t i = 0; i < g_newChunkStats.size() && i < (size_t)count; i++)
+		stats[i] = g_newChunkStats[i];
+}
+
 void VoxelManager::GetNewChunkIndices(const int count, glm::vec3 * indices)
 {
 	int i = 0;
@@ -237,7 +352,7 @@ void VoxelManager::GetNewChunkIndices(const int count, glm::vec3 * indices)
 
 void VoxelManager::BindChunk(const glm::vec3 &indices, const GLuint vbo, const GLuint ebo)
 {
-	Chunk * chunk = m_chunkMap[indices];
+	Chunk * chunk = FindChunk(indices);
 	if (chunk != nullptr && chunk->IsActive())
 	{
 		chunk->SetBuffers(vbo, ebo);
@@ -245,113 +360,207 @@ void VoxelManager::BindChunk(const glm::vec3 &indices, const GLuint vbo, const G
 	}
 }
 
-void VoxelManager::BindChunks(int count, glm::vec3 *indices, GLuint* vboArr, GLuint * eboArr)
+void VoxelManager::BindChunks(int count, glm::vec3 *indices, GLuint* vboArr, GLuint * eboArr, GLuint *seamEboArr)
 {
+	//chunks released before this bind began can no longer be found by it
+	vector<Chunk*> released;
+	{
+		std::lock_guard<std::mutex> lock(g_releasedLock);
+		released.swap(g_releasedChunks);
+	}
+
 	for (int i = 0; i < count; i++)
 	{
-		Chunk *chunk = m_chunkMap[indices[i]];		
+		Chunk *chunk = FindChunk(indices[i]);
 		if (chunk && chunk->GetVertexCount() > 0)
 		{
 			chunk->SetBuffers((GLuint)(size_t)vboArr[i], (GLuint)(size_t)eboArr[i]);
+			if (seamEboArr)
+				chunk->SetSeamBuffer((GLuint)(size_t)seamEboArr[i]);
 			chunk->BindMesh();			
 		}
 	}
 
 	g_newChunks.clear();
+	g_newChunkVertCount.clear();
+	g_newChunkTriCount.clear();
+	g_newChunkSeamTriCount.clear();
+	g_newChunkStats.clear();
+
+	for (Chunk *chunk : released)
+	{
+		chunk->Unload();
+		m_chunkPool.Release(chunk);
+	}
+}
+
+void VoxelManager::ReleaseChunk(Chunk *chunk)
+{
+	std::lock_guard<std::mutex> lock(g_releasedLock);
+	g_releasedChunks.push_back(chunk);
 }
 
 void VoxelManager::GetChunkMeshSizes(int * vertSizes, int * indiceSizes)
 {	
 	int i = 0;
-	for (auto &value : m_chunkMap) 
+	m_chunkGrid.ForEach([&](ChunkSlot &slot)
 	{
-		if (!value.second) continue;
-		if (i >= m_activeChunks) break;
-
-		Chunk *chunk = value.second;
+		Chunk *chunk = slot.chunk;
+		if (!chunk || i >= m_activeChunks) return;
 		if (chunk->GetVertexCount() == 0 || chunk->GetIndicesCount() == 0) 
-			continue;
+			return;
 
 		LogToUnity(to_string(i) + " chunk vert size: " + to_string(chunk->GetVertexCount()));
 		vertSizes[i] = chunk->GetVertexCount();
 		indiceSizes[i] = chunk->GetIndicesCount();
 
 		i++;
-	}
+	});
 }
 
 void VoxelManager::GetActiveChunkPositions(int count, glm::vec3 *positions)
 {
 	int i = 0;
-	for (auto &value : m_chunkMap)
+	m_chunkGrid.ForEach([&](ChunkSlot &slot)
 	{
-		if (!value.second) continue;
-		if (i >= count) break;
-
-		Chunk *chunk = value.second;
+		Chunk *chunk = slot.chunk;
+		if (!chunk || i >= count) return;
 		if (chunk->GetVertexCount() == 0 || chunk->GetIndicesCount() == 0)
-			continue;
+			return;
 
 		positions[i] = chunk->GetPosition();
 		i++;
-	}
+	});
 }
 
 void VoxelManager::CheckChunkJobs()
 {
-	for (int i = 0; i < g_genChunkTasks.size(); i++)
+	//neighbour links and seam regions are only touched while no seam job reads them
+	if (g_genSeamTasks.size() > 0)
+	{
+		DispatchChunkJobs();
+		return;
+	}
+
+	vector<Chunk*> generated;
 	{
-		if (g_genChunkTasks[i].GetIsComplete())
+		std::lock_guard<std::mutex> lock(g_generatedLock);
+		generated.swap(g_generatedChunks);
+	}
+
+	vector<Chunk*> seamChunks;
+	seamChunks.reserve(generated.size());
+	std::unordered_set<Chunk*> replaced;
+	const int retireRange = m_renderRange + VOXEL_STREAM_HYSTERESIS;
+	for (Chunk *chunk : generated)
+	{
+		//left the range while it was generated, or was queued again after being retired
+		const glm::ivec3 offset = glm::abs(chunk->m_chunkIndex - m_playerChunkIndex);
+		const int distance = glm::max(offset.x, glm::max(offset.y, offset.z));
+		ChunkSlot *slot = m_chunkGrid.Find(chunk->m_chunkIndex);
+		if (distance > retireRange || !slot || (slot->chunk && !slot->rebuilding))
+		{
+			if (slot && !slot->chunk)
+				m_chunkGrid.Erase(chunk->m_chunkIndex);
+			chunk->Unload();
+			m_chunkPool.Release(chunk);
+			continue;
+		}
+
+		//a rebuild for the new lod ring takes over from the chunk drawn meanwhile
+		if (slot->chunk)
+			replaced.insert(slot->chunk);
+		slot->rebuilding = false;
+
+		seamChunks.push_back(chunk);
+		slot->chunk = chunk;
+
+		//the player changed rings while it was generated
+		if (distance <= m_renderRange && chunk->GetLodLevel() != Chunk::GetLodLevel(distance, m_chunkSize))
 		{
-			GenerateChunkTaskSet * task = &g_genChunkTasks[i];
-			vector<Chunk*> seamChunks(task->m_SetSize);
+			slot->rebuilding = true;
+			m_chunkQueue.Push(slot->index);
+		}
+	}
 
-			for (int j = 0; j < task->m_SetSize; j++)
-			{
-				Chunk * chunk = &task->chunks[j];
-				seamChunks[j] = chunk;
-				m_chunkMap[chunk->m_chunkIndex] = chunk;
-			}
-			for (int j = 0; j < task->m_SetSize; j++)
-			{
-				Chunk * chunk = &task->chunks[j];
-				AssignChunkNeighbors(chunk);
-				//get a list of old chunks to regenerate seams
-				for (const auto neighbor : chunk->m_neighbors)
+	//neighbours on every side may still point at the replaced chunks, they are only
+	//released once nothing links to them
+	for (Chunk *chunk : replaced)
+	{
+		for (int x = -1; x <= 1; x++)
+			for (int y = -1; y <= 1; y++)
+				for (int z = -1; z <= 1; z++)
 				{
-					if (neighbor != nullptr && neighbor->HasGeneratedSeam() && neighbor->IsActive())
-					{
-						AssignChunkNeighbors(neighbor);
-						seamChunks.push_back(neighbor);
-					}
+					AssignChunkNeighbors(FindChunk(chunk->m_chunkIndex + glm::ivec3(x, y, z)));
 				}
-			}
+	}
+	if (!replaced.empty())
+	{
+		//a stale rebuild can be replaced by a later one arriving in the same batch
+		seamChunks.erase(std::remove_if(seamChunks.begin(), seamChunks.end(), [&](Chunk *chunk) { return replaced.count(chunk) > 0; }), seamChunks.end());
+		DropNewChunks(replaced);
+		for (Chunk *chunk : replaced)
+			ReleaseChunk(chunk);
+	}
+
+	const int generatedCount = seamChunks.size();
+	std::unordered_set<Chunk*> reseamed;
+	for (int j = 0; j < generatedCount; j++)
+	{
+		Chunk * chunk = seamChunks[j];
+		AssignChunkNeighbors(chunk);
 
-			GenerateSeamJob(seamChunks.size(), seamChunks);
-			g_genChunkTasks.erase(g_genChunkTasks.begin() + i);
+		//only chunks below, left or behind seam against the new one, and only
+		//their regions touching it are regenerated
+		for (int k = 1; k < 8; k++)
+		{
+			const glm::ivec3 offset(k & 1, (k >> 1) & 1, (k >> 2) & 1);
+			Chunk *neighbor = FindChunk(chunk->m_chunkIndex - offset);
+			if (!neighbor)
+				continue;
+
+			AssignChunkNeighbors(neighbor);
+			if (!neighbor->HasGeneratedSeam() || !neighbor->IsActive())
+				continue;
+
+			neighbor->MarkSeamDirty(offset);
+			if (reseamed.insert(neighbor).second)
+				seamChunks.push_back(neighbor);
 		}
 	}
+
+	if (seamChunks.size() > 0)
+	{
+		GenerateSeamJob(seamChunks.size(), seamChunks);
+		m_retirePending = true;
+	}
+
+	DispatchChunkJobs();
 }
 
 void VoxelManager::CheckSeamJobs()
 {
-	for (int i = 0; i < g_genSeamTasks.size(); i++)
+	for (size_t i = 0; i < g_genSeamTasks.size(); i++)
 	{
-		if (g_genSeamTasks[i].GetIsComplete())
+		if (g_genSeamTasks[i]->GetIsComplete())
 		{
-			GenerateSeamTask *task = &g_genSeamTasks[i];
+			GenerateSeamTask *task = g_genSeamTasks[i];
 
 			if (g_newChunks.size() == 0)
 				g_newChunks.reserve(task->m_SetSize);
-			for (int j = 0; j < task->m_SetSize; j++)
+			for (uint32_t j = 0; j < task->m_SetSize; j++)
 			{
 				Chunk *chunk = task->chunks[j];
 				g_newChunks.push_back(chunk);
 				g_newChunkVertCount.push_back(chunk->GetVertexCount());
 				g_newChunkTriCount.push_back(chunk->GetIndicesCount());
+				g_newChunkSeamTriCount.push_back(chunk->GetSeamIndicesCount());
+				g_newChunkStats.push_back(chunk->GetMeshStats());
 			}
 
 			g_genSeamTasks.erase(g_genSeamTasks.begin() + i);
+			delete task;
+			i--;
 			std::cout << "ChunkGen Complete! " << std::endl;			
 
 			if (g_newChunks.size() > 0)
@@ -360,10 +569,190 @@ void VoxelManager::CheckSeamJobs()
 	}
 }
 
-void VoxelManager::Update(glm::vec3 playerPos)
+void VoxelManager::StreamChunks(const glm::ivec3 &oldPlayerChunkIndex)
 {
-	glm::ivec3 newPlayerChunkIndex = glm::ivec3(playerPos) / m_chunkSize / m_voxelSize;
+	//only the part of the new render volume outside the old one can be missing
+	std::vector<glm::vec3> streamIndices;
+	for (int x = -m_renderRange; x <= m_renderRange; x++)
+	{
+		for (int z = -m_renderRange; z <= m_renderRange; z++)
+		{
+			for (int y = -m_renderRange; y <= m_renderRange; y++)
+			{
+				const glm::ivec3 index = m_playerChunkIndex + glm::ivec3(x, y, z);
+				const glm::ivec3 offset = glm::abs(index - oldPlayerChunkIndex);
+				if (glm::max(offset.x, glm::max(offset.y, offset.z)) <= m_renderRange)
+					continue;
+
+				ChunkSlot *slot = m_chunkGrid.Find(index);
+				if (!slot || !slot->queued)
+					streamIndices.push_back(index);
+			}
+		}
+	}
+
+	//queued chunks that left the render range are dropped before they are started
+	vector<glm::ivec3> cancelled;
+	m_chunkQueue.Cancel(m_renderRange, cancelled);
+	for (const glm::ivec3 &index : cancelled)
+	{
+		//a cancelled rebuild leaves its chunk in place
+		ChunkSlot *slot = m_chunkGrid.Find(index);
+		if (slot && slot->chunk)
+			slot->rebuilding = false;
+		else
+			m_chunkGrid.Erase(index);
+	}
+
+	if (streamIndices.size() > 0)
+		GenerateChunksInRange(streamIndices.size(), &streamIndices[0]);
+	m_retirePending = true;
+}
+
+void VoxelManager::RequeueLodChanges()
+{
+	m_chunkGrid.ForEach([&](ChunkSlot &slot)
+	{
+		if (!slot.chunk || slot.rebuilding)
+			return;
+
+		const glm::ivec3 offset = glm::abs(slot.index - m_playerChunkIndex);
+		const int distance = glm::max(offset.x, glm::max(offset.y, offset.z));
+		if (distance > m_renderRange || slot.chunk->GetLodLevel() == Chunk::GetLodLevel(distance, m_chunkSize))
+			return;
+
+		slot.rebuilding = true;
+		m_chunkQueue.Push(slot.index);
+	});
+
+	DispatchChunkJobs();
+}
+
+void VoxelManager::RetireChunks()
+{
+	//seam jobs may still read the chunks or their neighbours, chunk jobs only touch their own chunk
+	if (g_genSeamTasks.size() > 0)
+		return;
+	m_retirePending = false;
+
+	//chunks join the lru list when they leave the range and drop out of it when they come back
+	const int retireRange = m_renderRange + VOXEL_STREAM_HYSTERESIS;
+	size_t residentBytes = 0;
+	m_chunkGrid.ForEach([&](ChunkSlot &slot)
+	{
+		//chunks still generating are dropped once they finish
+		if (!slot.chunk) return;
+
+		const glm::ivec3 offset = glm::abs(slot.index - m_playerChunkIndex);
+		const bool outOfRange = glm::max(offset.x, glm::max(offset.y, offset.z)) > retireRange;
+
+		residentBytes += slot.chunk->GetMemoryUsage();
+		auto lruPos = m_lruPositions.find(slot.index);
+		if (outOfRange && lruPos == m_lruPositions.end())
+		{
+			m_lru.push_front(slot.index);
+			m_lruPositions[slot.index] = m_lru.begin();
+		}
+		else if (!outOfRange && lruPos != m_lruPositions.end())
+		{
+			m_lru.erase(lruPos->second);
+			m_lruPositions.erase(lruPos);
+		}
+	});
+
+	vector<glm::ivec3> retired;
+	std::unordered_set<Chunk*> evicted;
+	while (residentBytes > m_memoryBudget && !m_lru.empty())
+	{
+		const glm::ivec3 index = m_lru.back();
+		m_lru.pop_back();
+		m_lruPositions.erase(index);
+
+		Chunk *chunk = FindChunk(index);
+		residentBytes -= chunk->GetMemoryUsage();
+		m_chunkGrid.Erase(index);
+
+		evicted.insert(chunk);
+		retired.push_back(index);
+		g_retiredChunks.push_back(index);
+	}
+
+	//pooled chunks and build scratch count against the budget too, the pool gives up
+	//whatever room the resident chunks leave it
+	m_chunkPool.Trim(residentBytes < m_memoryBudget ? m_memoryBudget - residentBytes : 0);
+
+	if (retired.empty())
+		return;
+
+	DropNewChunks(evicted);
+
+	//unlink the chunks that kept a retired neighbour
+	for (const glm::ivec3 &index : retired)
+	{
+		for (int x = -1; x <= 1; x++)
+			for (int y = -1; y <= 1; y++)
+				for (int z = -1; z <= 1; z++)
+				{
+					AssignChunkNeighbors(FindChunk(index + glm::ivec3(x, y, z)));
+				}
+	}
+
+	for (Chunk *chunk : evicted)
+		ReleaseChunk(chunk);
+}
+
+int VoxelManager::GetRetiredChunkCount()
+{
+	return g_retiredChunks.size();
+}
+
+void VoxelManager::GetRetiredChunkIndices(const int count, glm::vec3 *indices)
+{
+	const size_t copied = std::min(g_retiredChunks.size(), (size_t)glm::max(count, 0));
+	for (size_t i = 0; i < copied; i++)
+		indices[i] = g_retiredChunks[i];
+
+	//indices that did not fit are kept for the next call
+	g_retiredChunks.erase(g_retiredChunks.begin(), g_retiredChunks.begin() + copied);
+}
+
+void VoxelManager::SetMemoryBudget(size_t bytes)
+{
+	m_memoryBudget = bytes;
+	m_retirePending = true;
+}
+
+void VoxelManager::SetHeightMapCacheCapacity(size_t tiles)
+{
+	Density::SetHeightMapCacheCapacity(tiles);
+}
+
+void VoxelManager::Update(glm::vec3 playerPos, glm::vec3 viewDirection)
+{
+	//floor so chunks on the negative side of an axis are not merged with chunk 0
+	glm::ivec3 newPlayerChunkIndex = glm::ivec3(glm::floor(playerPos / (float)(m_chunkSize * m_voxelSize)));
+	if (glm::length(viewDirection) > 0.f)
+		viewDirection = glm::normalize(viewDirection);
+
+	const bool moved = newPlayerChunkIndex != m_playerChunkIndex;
+	if (moved || glm::length(viewDirection - m_viewDirection) > VOXEL_VIEW_REFOCUS_DISTANCE)
+	{
+		m_viewDirection = viewDirection;
+		m_chunkQueue.SetFocus(newPlayerChunkIndex, m_viewDirection);
+	}
+
+	if (moved)
+	{
+		const glm::ivec3 oldPlayerChunkIndex = m_playerChunkIndex;
+		m_playerChunkIndex = newPlayerChunkIndex;
+		m_chunkGrid.Recenter(m_playerChunkIndex);
+		StreamChunks(oldPlayerChunkIndex);
+		RequeueLodChanges();
+	}
 
 	CheckChunkJobs();
 	CheckSeamJobs();
+
+	if (m_retirePending)
+		RetireChunks();
 }
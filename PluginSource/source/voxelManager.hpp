@@ -1,5 +1,11 @@
 #pragma once
 
+namespace enki { class TaskScheduler; }
+
+#define VOXEL_STREAM_HYSTERESIS 1 //chunks are kept this many chunks past the render range before they can be evicted
+#define VOXEL_MEMORY_BUDGET ((size_t)512 * 1024 * 1024) //bytes of chunk data, pooled chunks included, kept before chunks out of range are evicted
+#define VOXEL_VIEW_REFOCUS_DISTANCE 0.25f //change of the normalized view direction that reorders the generation queue
+
 class VoxelManager
 {
 	int m_voxelSize, 
@@ -10,11 +16,18 @@ class VoxelManager
 		m_totalChunks;
 
 	glm::ivec3 m_playerChunkIndex;	
+	glm::vec3 m_viewDirection; //normalized, zero when the caller gave none
+	bool m_retirePending; //the player moved or chunks arrived since residency was last checked
+
+	ChunkQueue m_chunkQueue; //chunks waiting for a worker, nearest first
+	ChunkPool m_chunkPool; //evicted chunks, reused by the workers
 
-	unordered_map<glm::ivec3, Chunk*> m_chunkMap;
-	unordered_map<glm::ivec3, bool> m_chunkInitMap;
+	size_t m_memoryBudget;
+	std::list<glm::ivec3> m_lru; //chunks out of range, the one that left first at the back
+	unordered_map<glm::ivec3, std::list<glm::ivec3>::iterator> m_lruPositions;
+
+	ChunkGrid m_chunkGrid; //queued and generated chunks around the player
 	std::vector<Chunk*> m_newChunks;
-	std::vector<Chunk*> m_chunks;
 
 public:
 	VoxelManager();
@@ -23,9 +36,16 @@ public:
 
 	void Init(int voxelSize, int range, float startRange, int chunkSize, float maxHeight);
 
+	//null until the chunk is generated
+	Chunk *FindChunk(const glm::ivec3 &index);
+
 	void AssignChunkNeighbors(Chunk *chunk);
 
+	//queues the chunks, workers generate them nearest to the player first
 	void GenerateChunksInRange(int count, glm::vec3 * indices);
+
+	//starts a chunk job for the queue unless one is still running
+	void DispatchChunkJobs();
 	
 	void GenerateSeamJob(int size, vector<Chunk*> chunks);
 
@@ -35,13 +55,24 @@ public:
 
 	void GetNewChunkTriangles(const int count, int * triCount);
 
+	//seam index counts of the new chunks, seams are drawn from their own buffers
+	void GetNewChunkSeamTriangles(const int count, int * triCount);
+
 	//void GetNewChunkMeshData(const int count, int * vertCount, int * triCount);
 
+	//a chunk rebuilt for another lod ring is listed again under its index, its mesh replaces the one bound before
 	void GetNewChunkIndices(const int count, glm::vec3 *indices);
 
+	//lod error and triangle counts of the new chunks, in GetNewChunkIndices order
+	void GetNewChunkStats(const int count, ChunkMeshStats *stats);
+
 	void BindChunk(const glm::vec3 & indices, const GLuint vbo, const GLuint ebo);
 
-	void BindChunks(int count, glm::vec3 * indices, GLuint * vboArr, GLuint * eboArr);
+	//seam buffers may be null, chunks that keep their body buffers only upload their seam
+	void BindChunks(int count, glm::vec3 * indices, GLuint * vboArr, GLuint * eboArr, GLuint * seamEboArr = nullptr);
+
+	//hands a chunk that left the grid back to the pool once the render thread can no longer be binding it
+	void ReleaseChunk(Chunk *chunk);
 
 	void GetChunkMeshSizes(int *vertSizes, int *indiceSizes);
 
@@ -51,5 +82,31 @@ public:
 
 	void CheckSeamJobs();
 
-	void Update(glm::vec3 playerPos);
+	//queues the chunks entering the render volume around the new player chunk
+	void StreamChunks(const glm::ivec3 &oldPlayerChunkIndex);
+
+	//queues a rebuild of every chunk in range whose lod ring changed, the chunk is drawn
+	//until its replacement arrives
+	void RequeueLodChanges();
+
+	//evicts chunks beyond the render range plus hysteresis, least recently in range first, until
+	//the rest fit the memory budget. Waits for running seam jobs to finish
+	void RetireChunks();
+
+	//chunks in range are never evicted, even over budget. The pool only keeps what they leave free
+	void SetMemoryBudget(size_t bytes);
+
+	//heightmap tiles kept for the terrain chunks, one tile per XZ chunk column
+	void SetHeightMapCacheCapacity(size_t tiles);
+
+	int GetRetiredChunkCount();
+
+	//hands up to count retired chunk indices over to the caller and forgets them, the rest stay queued
+	void GetRetiredChunkIndices(const int count, glm::vec3 *indices);
+
+	//viewDirection may be zero, otherwise chunks in front of the player are generated first
+	void Update(glm::vec3 playerPos, glm::vec3 viewDirection = glm::vec3(0.f));
+
+	//scheduler shared by chunk jobs, null until Init has started its worker threads
+	static enki::TaskScheduler *GetTaskScheduler();
 };
\ No newline at end of file